@@ -283,6 +283,8 @@ namespace MMAP
         }
 
         MMapData* mmap = itr->second;
+        std::lock_guard<std::mutex> guard(_queriesLock);
+
         if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
         {
             LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId {:03} instanceId {}", mapId, instanceId);
@@ -318,6 +320,8 @@ namespace MMAP
         }
 
         MMapData* mmap = itr->second;
+        std::lock_guard<std::mutex> guard(_queriesLock);
+
         if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
         {
             // check again after acquiring mutex
@@ -22,6 +22,7 @@
 #include "DetourAlloc.h"
 #include "DetourExtended.h"
 #include "DetourNavMesh.h"
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -68,6 +69,9 @@ namespace MMAP
 
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
 
+    // Region workers of a sharded map update can't share the query of the map, each worker slot gets own one
+    constexpr uint32 SHARDED_UPDATE_QUERY_ID = 0x80000000;
+
     // singleton class
     // holds all all access to mmap loading unloading and meshes
     class WH_COMMON_API MMapMgr
@@ -95,6 +99,7 @@ namespace MMAP
         [[nodiscard]] MMapDataSet::const_iterator GetMMapData(uint32 mapId) const;
 
         MMapDataSet loadedMMaps;
+        std::mutex _queriesLock; // queries of instances (and sharded update slots) are created from several map threads
         uint32 loadedTiles{0};
         bool thread_safe_environment{true};
     };
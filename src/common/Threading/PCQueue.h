@@ -74,6 +74,20 @@ public:
         return true;
     }
 
+    // pops the front element only if it satisfies the predicate, keeping the queue order intact
+    template <typename Predicate>
+    bool PopIf(T& value, Predicate&& predicate)
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+
+        if (_queue.empty() || _shutdown || !predicate(_queue.front()))
+            return false;
+
+        value = std::move(_queue.front());
+        _queue.pop();
+        return true;
+    }
+
     void WaitAndPop(T& value)
     {
         std::unique_lock<std::mutex> lock(_queueLock);
@@ -20,6 +20,7 @@
 
 #include "EventMap.h"
 #include "Random.h"
+#include <algorithm>
 
 void EventMap::Reset()
 {
@@ -68,7 +69,7 @@ void EventMap::ScheduleEvent(uint32 eventId, uint32 time, uint32 group /*= 0*/,
         eventId |= (1 << (phase + 23));
     }
 
-    _eventMap.emplace(_time + time, eventId);
+    Insert(_time + time, eventId);
 }
 
 void EventMap::ScheduleEvent(uint32 eventId, Milliseconds time, uint32 group /*= 0*/, uint8 phase /* = 0*/)
@@ -101,7 +102,7 @@ void EventMap::RescheduleEvent(uint32 eventId, Milliseconds minTime, Millisecond
 
 void EventMap::RepeatEvent(uint32 time)
 {
-    _eventMap.emplace(_time + time, _lastEvent);
+    Insert(_time + time, _lastEvent);
 }
 
 void EventMap::Repeat(Milliseconds time)
@@ -118,22 +119,19 @@ uint32 EventMap::ExecuteEvent()
 {
     while (!Empty())
     {
-        auto const& itr = _eventMap.begin();
+        std::pair<uint32, uint32> const next = _eventMap.back();
 
-        if (itr->first > _time)
+        if (next.first > _time)
         {
             return 0;
         }
-        else if (_phase && (itr->second & 0xFF000000) && !((itr->second >> 24) & _phase))
-        {
-            _eventMap.erase(itr);
-        }
-        else
+
+        _eventMap.pop_back();
+
+        if (!_phase || !(next.second & 0xFF000000) || ((next.second >> 24) & _phase))
         {
-            uint32 eventId = (itr->second & 0x0000FFFF);
-            _lastEvent = itr->second;
-            _eventMap.erase(itr);
-            return eventId;
+            _lastEvent = next.second;
+            return (next.second & 0x0000FFFF);
         }
     }
 
@@ -150,41 +148,77 @@ void EventMap::DelayEvents(Milliseconds delay)
     DelayEvents(delay.count());
 }
 
-void EventMap::DelayEventsToMax(uint32 delay, uint32 group)
+void EventMap::DelayEvents(uint32 delay, uint32 group)
 {
-    for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
+    if (group > 8 || Empty())
     {
-        if (itr->first < _time + delay && (group == 0 || ((1 << (group + 15)) & itr->second)))
+        return;
+    }
+
+    EventStore delayed;
+
+    // walked in occurrence order, delayed events keep their order
+    for (auto itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
+    {
+        if (!group || (itr->second & (1 << (group + 15))))
         {
-            ScheduleEvent(itr->second, delay);
-            _eventMap.erase(itr);
-            itr = _eventMap.begin();
-            continue;
+            delayed.emplace_back(itr->first + delay, itr->second);
         }
+    }
 
-        ++itr;
+    if (delayed.empty())
+    {
+        return;
+    }
+
+    std::erase_if(_eventMap, [group](std::pair<uint32, uint32> const& event) { return !group || (event.second & (1 << (group + 15))); });
+
+    for (std::pair<uint32, uint32> const& event : delayed)
+    {
+        Insert(event.first, event.second);
     }
 }
 
-void EventMap::CancelEvent(uint32 eventId)
+void EventMap::DelayEventsToMax(uint32 delay, uint32 group)
 {
-    if (Empty())
+    auto isDelayed = [this, delay, group](std::pair<uint32, uint32> const& event)
     {
-        return;
-    }
+        return event.first < _time + delay && (group == 0 || ((1 << (group + 15)) & event.second));
+    };
 
-    for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
+    std::vector<uint32> delayed;
+
+    for (auto itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
     {
-        if (eventId == (itr->second & 0x0000FFFF))
+        if (isDelayed(*itr))
         {
-            itr = _eventMap.erase(itr);
-            continue;
+            delayed.push_back(itr->second);
         }
+    }
 
-        ++itr;
+    if (delayed.empty())
+    {
+        return;
+    }
+
+    std::erase_if(_eventMap, isDelayed);
+
+    for (uint32 data : delayed)
+    {
+        Insert(_time + delay, data);
     }
 }
 
+void EventMap::CancelEvent(uint32 eventId)
+{
+    if (Empty())
+    {
+        return;
+    }
+
+    std::erase_if(_eventMap, [eventId](std::pair<uint32, uint32> const& event) { return eventId == (event.second & 0x0000FFFF); });
+}
+
 void EventMap::CancelEventGroup(uint32 group)
 {
     if (!group || group > 8 || Empty())
@@ -193,17 +227,7 @@ void EventMap::CancelEventGroup(uint32 group)
     }
 
     uint32 groupMask = (1 << (group + 15));
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
-    {
-        if (itr->second & groupMask)
-        {
-            _eventMap.erase(itr);
-            itr = _eventMap.begin();
-            continue;
-        }
-
-        ++itr;
-    }
+    std::erase_if(_eventMap, [groupMask](std::pair<uint32, uint32> const& event) { return event.second & groupMask; });
 }
 
 uint32 EventMap::GetNextEventTime(uint32 eventId) const
@@ -213,11 +237,11 @@ uint32 EventMap::GetNextEventTime(uint32 eventId) const
         return 0;
     }
 
-    for (auto const& itr : _eventMap)
+    for (auto itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
     {
-        if (eventId == (itr.second & 0x0000FFFF))
+        if (eventId == (itr->second & 0x0000FFFF))
         {
-            return itr.first;
+            return itr->first;
         }
     }
 
@@ -226,7 +250,7 @@ uint32 EventMap::GetNextEventTime(uint32 eventId) const
 
 uint32 EventMap::GetNextEventTime() const
 {
-    return Empty() ? 0 : _eventMap.begin()->first;
+    return Empty() ? 0 : _eventMap.back().first;
 }
 
 bool EventMap::IsInPhase(uint8 phase)
@@ -236,9 +260,16 @@ bool EventMap::IsInPhase(uint8 phase)
 
 Milliseconds EventMap::GetTimeUntilEvent(uint32 eventId) const
 {
-    for (std::pair<uint32 const, uint32> const& itr : _eventMap)
-        if (eventId == (itr.second & 0x0000FFFF))
-            return std::chrono::duration_cast<Milliseconds>(Milliseconds(itr.first) - Milliseconds(_time));
+    for (auto itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
+        if (eventId == (itr->second & 0x0000FFFF))
+            return std::chrono::duration_cast<Milliseconds>(Milliseconds(itr->first) - Milliseconds(_time));
 
     return Milliseconds::max();
 }
+
+void EventMap::Insert(uint32 time, uint32 data)
+{
+    // in front of the events of the same time, they occur first
+    auto itr = std::partition_point(_eventMap.begin(), _eventMap.end(), [time](std::pair<uint32, uint32> const& event) { return event.first > time; });
+    _eventMap.emplace(itr, time, data);
+}
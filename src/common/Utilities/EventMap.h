@@ -20,14 +20,18 @@
 
 #include "Define.h"
 #include "Duration.h"
-#include <map>
+#include <utility>
+#include <vector>
 
 class WH_COMMON_API EventMap
 {
     /**
     * Internal storage type.
-    * Key: Time as TimePoint when the event should occur.
-    * Value: The event data as uint32.
+    * First: Time as TimePoint when the event should occur.
+    * Second: The event data as uint32.
+    *
+    * Kept sorted by descending time, the next event is the last element.
+    * Events of the same time occur in the order they were scheduled.
     *
     * Structure of event data:
     * - Bit  0 - 15: Event Id.
@@ -35,7 +39,7 @@ class WH_COMMON_API EventMap
     * - Bit 24 - 31: Phase
     * - Pattern: 0xPPGGEEEE
     */
-    typedef std::multimap<uint32, uint32> EventStore;
+    typedef std::vector<std::pair<uint32, uint32>> EventStore;
 
 public:
     EventMap() { }
@@ -231,29 +235,7 @@ public:
     * @param delay Amount of delay.
     * @param group Group of the events.
     */
-    void DelayEvents(uint32 delay, uint32 group)
-    {
-        if (group > 8 || Empty())
-        {
-            return;
-        }
-
-        EventStore delayed;
-
-        for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
-        {
-            if (!group || (itr->second & (1 << (group + 15))))
-            {
-                delayed.insert(EventStore::value_type(itr->first + delay, itr->second));
-                itr = _eventMap.erase(itr);
-                continue;
-            }
-
-            ++itr;
-        }
-
-        _eventMap.insert(delayed.begin(), delayed.end());
-    }
+    void DelayEvents(uint32 delay, uint32 group);
 
     // DelayEventsToMax
     void DelayEventsToMax(uint32 delay, uint32 group);
@@ -303,6 +285,14 @@ public:
     Milliseconds GetTimeUntilEvent(uint32 eventId) const;
 
 private:
+    /**
+    * @name Insert
+    * @brief Adds an event, it occurs after the events already scheduled for the same time.
+    * @param time Time value of the event.
+    * @param data The event data.
+    */
+    void Insert(uint32 time, uint32 data);
+
     /**
     * @name _time
     * @brief Internal timer.
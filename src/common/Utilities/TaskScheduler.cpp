@@ -20,6 +20,8 @@
 
 #include "TaskScheduler.h"
 #include "Errors.h"
+#include <algorithm>
+#include <iterator>
 
 TaskScheduler& TaskScheduler::ClearValidator()
 {
@@ -129,19 +131,21 @@ bool TaskScheduler::IsGroupScheduled(group_t const group)
 
 void TaskScheduler::TaskQueue::Push(TaskContainer&& task)
 {
-    container.insert(task);
+    // in front of the tasks of the same time, they run first
+    auto itr = std::partition_point(container.begin(), container.end(), [&task](TaskContainer const& other) { return *task < *other; });
+    container.insert(itr, std::move(task));
 }
 
 auto TaskScheduler::TaskQueue::Pop() -> TaskContainer
 {
-    TaskContainer result = *container.begin();
-    container.erase(container.begin());
+    TaskContainer result = std::move(container.back());
+    container.pop_back();
     return result;
 }
 
 auto TaskScheduler::TaskQueue::First() const -> TaskContainer const&
 {
-    return *container.begin();
+    return container.back();
 }
 
 void TaskScheduler::TaskQueue::Clear()
@@ -151,32 +155,20 @@ void TaskScheduler::TaskQueue::Clear()
 
 void TaskScheduler::TaskQueue::RemoveIf(std::function<bool(TaskContainer const&)> const& filter)
 {
-    for (auto itr = container.begin(); itr != container.end();)
-        if (filter(*itr))
-        {
-            itr = container.erase(itr);
-        }
-        else
-        {
-            ++itr;
-        }
+    std::erase_if(container, filter);
 }
 
 void TaskScheduler::TaskQueue::ModifyIf(std::function<bool(TaskContainer const&)> const& filter)
 {
     std::vector<TaskContainer> cache;
-    for (auto itr = container.begin(); itr != container.end();)
-        if (filter(*itr))
-        {
-            cache.push_back(*itr);
-            itr = container.erase(itr);
-        }
-        else
-        {
-            ++itr;
-        }
 
-    container.insert(cache.begin(), cache.end());
+    // the filter may change the time of a task, those are taken out and sorted in again
+    auto itr = std::stable_partition(container.begin(), container.end(), [&filter](TaskContainer const& task) { return !filter(task); });
+    std::move(itr, container.end(), std::back_inserter(cache));
+    container.erase(itr, container.end());
+
+    for (auto task = cache.rbegin(); task != cache.rend(); ++task)
+        Push(std::move(*task));
 }
 
 bool TaskScheduler::TaskQueue::IsGroupQueued(group_t const group)
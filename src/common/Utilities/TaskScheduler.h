@@ -24,7 +24,6 @@
 #include <memory>
 #include <optional>
 #include <queue>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -120,17 +119,10 @@ class WH_COMMON_API TaskScheduler
     typedef std::shared_ptr<Task> TaskContainer;
 
     /// Container which provides Task order, insert and reschedule operations.
-    struct Compare
-    {
-        bool operator() (TaskContainer const& left, TaskContainer const& right) const
-        {
-            return (*left.get()) < (*right.get());
-        };
-    };
-
     class WH_COMMON_API TaskQueue
     {
-        std::multiset<TaskContainer, Compare> container;
+        // Sorted by descending time, the next task is the last element
+        std::vector<TaskContainer> container;
 
     public:
         // Pushes the task in the container
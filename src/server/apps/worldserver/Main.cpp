@@ -51,6 +51,7 @@
 #include "SharedDefines.h"
 #include "SignalHandlerMgr.h"
 #include "ThreadPool.h"
+#include "UpdateData.h"
 #include "World.h"
 #include "WorldSocket.h"
 #include "WorldSocketMgr.h"
@@ -280,6 +281,10 @@ int main(int argc, char** argv)
         METRIC_VALUE("db_queue_login", uint64(AuthDatabase.GetQueueSize()));
         METRIC_VALUE("db_queue_character", uint64(CharacterDatabase.GetQueueSize()));
         METRIC_VALUE("db_queue_world", uint64(WorldDatabase.GetQueueSize()));
+        METRIC_VALUE("packet_body_bytes", WorldSocket::GetCopiedPacketBytes(), METRIC_TAG("type", "copied"));
+        METRIC_VALUE("packet_body_bytes", WorldSocket::GetSharedPacketBytes(), METRIC_TAG("type", "shared"));
+        METRIC_VALUE("update_object_bytes", UpdateData::GetRawBytes(), METRIC_TAG("type", "raw"));
+        METRIC_VALUE("update_object_bytes", UpdateData::GetCompressedBytes(), METRIC_TAG("type", "compressed"));
     });
 
     METRIC_EVENT("events", "Worldserver started", "");
@@ -19,6 +19,7 @@
 #include "DatabaseWorkerPool.h"
 #include "MySQLConnection.h"
 #include "QueryResult.h"
+#include "Transaction.h"
 #include <utility>
 
 BasicStatementTask::BasicStatementTask(std::string_view sql, bool isAsync /*= false*/) :
@@ -71,6 +72,11 @@ void PreparedStatementTask::ExecuteQuery()
     _connection->Execute(_stmt);
 }
 
+void PreparedStatementTask::AppendTo(Transaction& transaction)
+{
+    transaction.Append(_stmt);
+}
+
 void CheckAsyncQueueTask::Execute()
 {
     _dbPool->CheckAsyncQueue();
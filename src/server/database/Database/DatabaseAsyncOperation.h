@@ -33,6 +33,10 @@ public:
     virtual void ExecuteQuery() = 0;
     inline void SetConnection(MySQLConnection* connection) { _connection = connection; }
 
+    // one-way statements the async worker may run together with its neighbours in a single transaction
+    [[nodiscard]] virtual bool CanBatch() const { return false; }
+    virtual void AppendTo(Transaction& /*transaction*/) { }
+
 protected:
     MySQLConnection* _connection{ nullptr };
     bool _hasResult{};
@@ -63,6 +67,8 @@ public:
     ~PreparedStatementTask() override = default;
 
     void ExecuteQuery() override;
+    [[nodiscard]] bool CanBatch() const override { return !_hasResult; }
+    void AppendTo(Transaction& transaction) override;
     [[nodiscard]] PreparedQueryResultFuture GetFuture() const { return _result->get_future(); }
 
 private:
@@ -17,12 +17,18 @@
 
 #include "DatabaseAsyncQueueWorker.h"
 #include "DatabaseAsyncOperation.h"
+#include "Config.h"
+#include "Log.h"
+#include "MySQLConnection.h"
 #include "PCQueue.h"
+#include "Transaction.h"
+#include <algorithm>
 
 AsyncDBQueueWorker::AsyncDBQueueWorker(ProducerConsumerQueue<AsyncOperation*>* dbQueue, MySQLConnection* connection)
 {
     _connection = connection;
     _queue = dbQueue;
+    _batchSize = std::max<uint32>(sConfigMgr->GetOption<uint32>("Database.AsyncBatchSize", 1), 1);
     _thread = std::thread(&AsyncDBQueueWorker::ExecuteAsyncQueue, this);
 }
 
@@ -52,12 +58,51 @@ void AsyncDBQueueWorker::ExecuteAsyncQueue()
         if (!operation)
             continue;
 
+        // only consecutive statements are taken, so they still hit the database in the order they were queued
+        if (_batchSize > 1 && operation->CanBatch())
+        {
+            std::vector<AsyncOperation*> batch{ operation };
+
+            AsyncOperation* next{ nullptr };
+            while (batch.size() < _batchSize && _queue->PopIf(next, [](AsyncOperation* op) { return op->CanBatch(); }))
+                batch.emplace_back(next);
+
+            if (batch.size() > 1)
+            {
+                ExecuteBatch(batch);
+                continue;
+            }
+        }
+
         operation->SetConnection(_connection);
         operation->ExecuteQuery();
         delete operation;
     }
 }
 
+void AsyncDBQueueWorker::ExecuteBatch(std::vector<AsyncOperation*>& batch)
+{
+    SQLTransaction transaction = std::make_shared<Transaction>();
+    for (AsyncOperation* operation : batch)
+        operation->AppendTo(*transaction);
+
+    // the batch was rolled back, run the statements one by one as if they were never batched
+    // so a single failing statement doesn't take its neighbours with it
+    if (int32 errorCode = _connection->ExecuteTransaction(transaction))
+    {
+        LOG_WARN("db.query", "Batch of {} statements failed ({}), executing them separately.", batch.size(), errorCode);
+
+        for (AsyncOperation* operation : batch)
+        {
+            operation->SetConnection(_connection);
+            operation->ExecuteQuery();
+        }
+    }
+
+    for (AsyncOperation* operation : batch)
+        delete operation;
+}
+
 AsyncDBQueueChecker::AsyncDBQueueChecker(ProducerConsumerQueue<CheckAsyncQueueTask*>* dbQueue)
 {
     _queue = dbQueue;
@@ -21,6 +21,7 @@
 #include "Define.h"
 #include <atomic>
 #include <thread>
+#include <vector>
 
 template <typename T>
 class ProducerConsumerQueue;
@@ -37,9 +38,11 @@ public:
 
 private:
     void ExecuteAsyncQueue();
+    void ExecuteBatch(std::vector<AsyncOperation*>& batch);
 
     ProducerConsumerQueue<AsyncOperation*>* _queue;
     MySQLConnection* _connection;
+    uint32 _batchSize;
 
     std::thread _thread;
     std::atomic<bool> _cancel{ false };
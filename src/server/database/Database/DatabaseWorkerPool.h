@@ -222,6 +222,7 @@ public:
 
     void Update(Milliseconds diff);
     [[nodiscard]] std::size_t GetQueueSize() const;
+    [[nodiscard]] std::size_t GetAsyncConnectionCount() const { return _connections[IDX_ASYNC].size(); }
 
     void OpenDynamicAsyncConnect();
     void OpenDynamicSyncConnect();
@@ -85,6 +85,7 @@ class WH_DATABASE_API Field
 {
     friend class ResultSet;
     friend class PreparedResultSet;
+    friend class PreparedResultColumns;
 
 public:
     Field();
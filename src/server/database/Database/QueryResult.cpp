@@ -22,6 +22,8 @@
 #include "Errors.h"
 #include "Log.h"
 #include "MySQLHacks.h"
+#include <algorithm>
+#include <cstring>
 
 namespace
 {
@@ -181,13 +183,71 @@ ResultSet::ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, u
     }
 }
 
+ResultSet::ResultSet(std::shared_ptr<ResultSetRows const> rows) :
+    _fieldMetadata(rows->Fields),
+    _rowCount(rows->RowCount),
+    _fieldCount(uint32(rows->Fields.size())),
+    _result(nullptr),
+    _fields(nullptr),
+    _rows(std::move(rows))
+{
+    _currRow = std::make_unique<Field[]>(_fieldCount);
+
+    for (uint32 i = 0; i < _fieldCount; i++)
+        _currRow[i].SetMetadata(&_fieldMetadata[i]);
+}
+
 ResultSet::~ResultSet()
 {
     CleanUp();
 }
 
+/*static*/ QueryResult ResultSet::FromRows(std::shared_ptr<ResultSetRows const> rows)
+{
+    if (!rows || !rows->RowCount || rows->Fields.empty())
+        return nullptr;
+
+    QueryResult result(new ResultSet(std::move(rows)));
+    if (!result->NextRow())
+        return nullptr;
+
+    return result;
+}
+
+std::shared_ptr<ResultSetRows> ResultSet::TakeRows()
+{
+    auto rows = std::make_shared<ResultSetRows>();
+    rows->Fields = _fieldMetadata;
+    rows->Data.reserve(std::size_t(_rowCount) * _fieldCount * 8);
+
+    do
+    {
+        for (uint32 i = 0; i < _fieldCount; i++)
+        {
+            Field const& field = _currRow[i];
+            uint32 length = field.data.value ? field.data.length : ResultSetRows::NULL_VALUE;
+
+            char const* lengthBytes = reinterpret_cast<char const*>(&length);
+            rows->Data.insert(rows->Data.end(), lengthBytes, lengthBytes + sizeof(length));
+
+            if (!field.data.value)
+                continue;
+
+            rows->Data.insert(rows->Data.end(), field.data.value, field.data.value + field.data.length);
+            rows->Data.push_back('\0');
+        }
+
+        ++rows->RowCount;
+    } while (NextRow());
+
+    return rows;
+}
+
 bool ResultSet::NextRow()
 {
+    if (_rows)
+        return NextStoredRow();
+
     if (!_result)
         return false;
 
@@ -212,10 +272,35 @@ bool ResultSet::NextRow()
     return true;
 }
 
+bool ResultSet::NextStoredRow()
+{
+    std::vector<char> const& data = _rows->Data;
+    if (_rowsOffset >= data.size())
+        return false;
+
+    for (uint32 i = 0; i < _fieldCount; i++)
+    {
+        uint32 length;
+        memcpy(&length, data.data() + _rowsOffset, sizeof(length));
+        _rowsOffset += sizeof(length);
+
+        if (length == ResultSetRows::NULL_VALUE)
+        {
+            _currRow[i].SetStructuredValue(nullptr, 0);
+            continue;
+        }
+
+        _currRow[i].SetStructuredValue(data.data() + _rowsOffset, length);
+        _rowsOffset += length + 1;
+    }
+
+    return true;
+}
+
 std::string ResultSet::GetFieldName(uint32 index) const
 {
     ASSERT(index < _fieldCount);
-    return _fields[index].name;
+    return _fieldMetadata[index].Alias;
 }
 
 void ResultSet::CleanUp()
@@ -238,6 +323,51 @@ void ResultSet::AssertRows(std::size_t sizeRows) const
     ASSERT(sizeRows == _fieldCount);
 }
 
+void PreparedResultColumns::Allocate(uint32 const* slotSizes, uint32 columnCount, uint64 rowCount)
+{
+    // [column table][lengths, column by column][data, column by column]
+    std::size_t tableSize = sizeof(Column) * columnCount;
+    std::size_t lengthsSize = sizeof(uint32) * columnCount * rowCount;
+    std::size_t dataSize = 0;
+
+    for (uint32 i = 0; i < columnCount; ++i)
+        dataSize += std::size_t(slotSizes[i]) * rowCount;
+
+    _size = tableSize + lengthsSize + dataSize;
+    _arena.reset(new char[_size]);
+    _columns = reinterpret_cast<Column*>(_arena.get());
+    _lengths = reinterpret_cast<uint32*>(_arena.get() + tableSize);
+    _data = _arena.get() + tableSize + lengthsSize;
+    _rowCount = rowCount;
+    _columnCount = columnCount;
+
+    std::size_t offset = 0;
+    for (uint32 i = 0; i < columnCount; ++i)
+    {
+        _columns[i].Offset = offset;
+        _columns[i].Size = slotSizes[i];
+        offset += std::size_t(slotSizes[i]) * rowCount;
+    }
+}
+
+void PreparedResultColumns::InitializeRow(Field* fields, QueryResultFieldMetadata const* metadata) const
+{
+    for (uint32 i = 0; i < _columnCount; ++i)
+        fields[i].SetMetadata(&metadata[i]);
+}
+
+void PreparedResultColumns::ReadRow(uint64 row, Field* fields) const
+{
+    for (uint32 i = 0; i < _columnCount; ++i)
+    {
+        uint32 length = _lengths[i * _rowCount + row];
+        if (length == NULL_LENGTH)
+            fields[i].SetByteValue(nullptr, 0);
+        else
+            fields[i].SetByteValue(GetSlot(i, row), length);
+    }
+}
+
 PreparedResultSet::PreparedResultSet(MySQLStmt* stmt, MySQLResult* result, uint64 rowCount, uint32 fieldCount) :
     _rowCount(rowCount),
     _fieldCount(fieldCount),
@@ -280,12 +410,10 @@ PreparedResultSet::PreparedResultSet(MySQLStmt* stmt, MySQLResult* result, uint6
     //- This is where we prepare the buffer based on metadata
     auto* field = reinterpret_cast<MySQLField*>(mysql_fetch_fields(_metadataResult));
     _fieldMetadata.resize(_fieldCount);
-    std::size_t rowSize = 0;
 
     for (uint32 i = 0; i < _fieldCount; ++i)
     {
         uint32 size = SizeForType(&field[i]);
-        rowSize += size;
 
         InitializeDatabaseFieldMetadata(&_fieldMetadata[i], &field[i], i);
 
@@ -297,12 +425,15 @@ PreparedResultSet::PreparedResultSet(MySQLStmt* stmt, MySQLResult* result, uint6
         _rBind[i].is_unsigned = field[i].flags & UNSIGNED_FLAG;
     }
 
-    char* dataBuffer = new char[rowSize * _rowCount];
-    for (uint32 i = 0, offset = 0; i < _fieldCount; ++i)
-    {
-        _rBind[i].buffer = dataBuffer + offset;
-        offset += _rBind[i].buffer_length;
-    }
+    std::vector<uint32> slotSizes(_fieldCount);
+    for (uint32 i = 0; i < _fieldCount; ++i)
+        slotSizes[i] = uint32(_rBind[i].buffer_length);
+
+    //- One buffer for the whole result, a slot per value
+    _columns.Allocate(slotSizes.data(), _fieldCount, _rowCount);
+
+    for (uint32 i = 0; i < _fieldCount; ++i)
+        _rBind[i].buffer = _columns.GetSlot(i, 0);
 
     //- This is where we bind the bind the buffer to the statement
     if (mysql_stmt_bind_result(_stmt, _rBind))
@@ -315,54 +446,62 @@ PreparedResultSet::PreparedResultSet(MySQLStmt* stmt, MySQLResult* result, uint6
         return;
     }
 
-    _rows.resize(uint32(_rowCount) * _fieldCount);
-
-    while (_NextRow())
+    for (uint64 row = 0; row < _rowCount; ++row)
     {
+        // fetch straight into the slots of this row
         for (uint32 fIndex = 0; fIndex < _fieldCount; ++fIndex)
+            _stmt->bind[fIndex].buffer = _columns.GetSlot(fIndex, row);
+
+        int mysqlStmtFetch = mysql_stmt_fetch(_stmt);
+        if (mysqlStmtFetch != 0 && mysqlStmtFetch != MYSQL_DATA_TRUNCATED)
         {
-            _rows[uint32(_rowPosition) * _fieldCount + fIndex].SetMetadata(&_fieldMetadata[fIndex]);
+            LOG_WARN("db.query", "{}:mysql_stmt_fetch, stopped after {} of {} rows. Error: {}", __FUNCTION__, row, _rowCount, mysql_stmt_error(_stmt));
+            _rowCount = row;
+            break;
+        }
 
-            unsigned long buffer_length = _rBind[fIndex].buffer_length;
-            unsigned long fetched_length = *_rBind[fIndex].length;
-            if (!*_rBind[fIndex].is_null)
+        for (uint32 fIndex = 0; fIndex < _fieldCount; ++fIndex)
+        {
+            if (*_rBind[fIndex].is_null)
             {
-                void* buffer = _stmt->bind[fIndex].buffer;
-                switch (_rBind[fIndex].buffer_type)
-                {
-                    case MYSQL_TYPE_TINY_BLOB:
-                    case MYSQL_TYPE_MEDIUM_BLOB:
-                    case MYSQL_TYPE_LONG_BLOB:
-                    case MYSQL_TYPE_BLOB:
-                    case MYSQL_TYPE_STRING:
-                    case MYSQL_TYPE_VAR_STRING:
-                        // warning - the string will not be null-terminated if there is no space for it in the buffer
-                        // when mysql_stmt_fetch returned MYSQL_DATA_TRUNCATED
-                        // we cannot blindly null-terminate the data either as it may be retrieved as binary blob and not specifically a string
-                        // in this case using Field::GetCString will result in garbage
-                        // TODO: remove Field::GetCString and use std::string_view in C++17
-                        if (fetched_length < buffer_length)
-                            *((char*)buffer + fetched_length) = '\0';
-                        break;
-                    default:
-                        break;
-                }
-
-                _rows[uint32(_rowPosition) * _fieldCount + fIndex].SetByteValue((char const*)buffer, fetched_length);
-
-                // move buffer pointer to next part
-                _stmt->bind[fIndex].buffer = (char*)buffer + rowSize;
+                _columns.SetLength(fIndex, row, PreparedResultColumns::NULL_LENGTH);
+                continue;
             }
-            else
+
+            unsigned long buffer_length = _rBind[fIndex].buffer_length;
+            unsigned long fetched_length = *_rBind[fIndex].length;
+            char* buffer = _columns.GetSlot(fIndex, row);
+
+            switch (_rBind[fIndex].buffer_type)
             {
-                _rows[uint32(_rowPosition) * _fieldCount + fIndex].SetByteValue(nullptr, *_rBind[fIndex].length);
+                case MYSQL_TYPE_TINY_BLOB:
+                case MYSQL_TYPE_MEDIUM_BLOB:
+                case MYSQL_TYPE_LONG_BLOB:
+                case MYSQL_TYPE_BLOB:
+                case MYSQL_TYPE_STRING:
+                case MYSQL_TYPE_VAR_STRING:
+                    // warning - the string will not be null-terminated if there is no space for it in the buffer
+                    // when mysql_stmt_fetch returned MYSQL_DATA_TRUNCATED
+                    // we cannot blindly null-terminate the data either as it may be retrieved as binary blob and not specifically a string
+                    // in this case using Field::GetCString will result in garbage
+                    // TODO: remove Field::GetCString and use std::string_view in C++17
+                    if (fetched_length < buffer_length)
+                        buffer[fetched_length] = '\0';
+                    break;
+                default:
+                    break;
             }
-        }
 
-        _rowPosition++;
+            // a truncated value must not reach into the slot of the next row
+            _columns.SetLength(fIndex, row, uint32(std::min(fetched_length, buffer_length)));
+        }
     }
 
+    _currRow = std::make_unique<Field[]>(_fieldCount);
+    _columns.InitializeRow(_currRow.get(), _fieldMetadata.data());
+
     _rowPosition = 0;
+    ReadCurrentRow();
 
     /// All data is buffered, let go of mysql c api structures
     mysql_stmt_free_result(_stmt);
@@ -375,36 +514,31 @@ PreparedResultSet::~PreparedResultSet()
 
 bool PreparedResultSet::NextRow()
 {
-    /// Only updates the m_rowPosition so upper level code knows in which element
-    /// of the rows vector to look
+    /// Only moves the fields to the values of the next row, they are decoded when read
     if (++_rowPosition >= _rowCount)
         return false;
 
+    ReadCurrentRow();
     return true;
 }
 
-bool PreparedResultSet::_NextRow()
+void PreparedResultSet::ReadCurrentRow()
 {
-    /// Only called in low-level code, namely the constructor
-    /// Will iterate over every row of data and buffer it
-    if (_rowPosition >= _rowCount)
-        return false;
-
-    int mysqlStmtFetch = mysql_stmt_fetch(_stmt);
-    return mysqlStmtFetch == 0 || mysqlStmtFetch == MYSQL_DATA_TRUNCATED;
+    if (_rowPosition < _rowCount)
+        _columns.ReadRow(_rowPosition, _currRow.get());
 }
 
 Field* PreparedResultSet::Fetch() const
 {
     ASSERT(_rowPosition < _rowCount);
-    return const_cast<Field*>(&_rows[uint32(_rowPosition) * _fieldCount]);
+    return _currRow.get();
 }
 
 Field const& PreparedResultSet::operator[](std::size_t index) const
 {
     ASSERT(_rowPosition < _rowCount);
     ASSERT(index < _fieldCount);
-    return _rows[uint32(_rowPosition) * _fieldCount + index];
+    return _currRow[index];
 }
 
 void PreparedResultSet::CleanUp()
@@ -414,7 +548,6 @@ void PreparedResultSet::CleanUp()
 
     if (_rBind)
     {
-        delete[] (char*)_rBind->buffer;
         delete[] _rBind;
         _rBind = nullptr;
     }
@@ -20,6 +20,7 @@
 
 #include "DatabaseEnvFwd.h"
 #include "Field.h"
+#include <memory>
 #include <unordered_map>
 
 template<typename T>
@@ -43,12 +44,32 @@ private:
     pointer _ptr;
 };
 
+/*
+  Rows of a text protocol result copied out of the client library buffers.
+  Every value is stored as its uint32 length (NULL_VALUE for NULL), the bytes and a terminating '\0',
+  so replayed fields point straight into Data.
+*/
+struct WH_DATABASE_API ResultSetRows
+{
+    static constexpr uint32 NULL_VALUE = 0xFFFFFFFF;
+
+    std::vector<QueryResultFieldMetadata> Fields;
+    uint64 RowCount{ 0 };
+    std::vector<char> Data;
+};
+
 class WH_DATABASE_API ResultSet
 {
 public:
     ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount);
     ~ResultSet();
 
+    // Result positioned on the first stored row, nullptr for no rows like an empty query
+    static QueryResult FromRows(std::shared_ptr<ResultSetRows const> rows);
+
+    // Copies the current and all remaining rows, the result set is exhausted afterwards
+    [[nodiscard]] std::shared_ptr<ResultSetRows> TakeRows();
+
     bool NextRow();
     [[nodiscard]] uint64 GetRowCount() const { return _rowCount; }
     [[nodiscard]] uint32 GetFieldCount() const { return _fieldCount; }
@@ -83,16 +104,68 @@ protected:
     uint32 _fieldCount;
 
 private:
+    explicit ResultSet(std::shared_ptr<ResultSetRows const> rows);
+
     void CleanUp();
+    bool NextStoredRow();
     void AssertRows(std::size_t sizeRows) const;
 
     MySQLResult* _result;
     MySQLField* _fields;
+    std::shared_ptr<ResultSetRows const> _rows;
+    std::size_t _rowsOffset{ 0 };
 
     ResultSet(ResultSet const& right) = delete;
     ResultSet& operator=(ResultSet const& right) = delete;
 };
 
+/*
+  Buffered rows of a prepared statement result, stored by column in one allocation.
+  Every column holds a slot of its bind size per row, the fetched lengths of all values follow
+  the columns. Fields are only pointed at the values of the row being read.
+*/
+class WH_DATABASE_API PreparedResultColumns
+{
+public:
+    static constexpr uint32 NULL_LENGTH = 0xFFFFFFFF;
+
+    PreparedResultColumns() = default;
+
+    void Allocate(uint32 const* slotSizes, uint32 columnCount, uint64 rowCount);
+
+    [[nodiscard]] char* GetSlot(uint32 column, uint64 row) const { return _data + _columns[column].Offset + row * _columns[column].Size; }
+    [[nodiscard]] uint32 GetSlotSize(uint32 column) const { return _columns[column].Size; }
+    void SetLength(uint32 column, uint64 row, uint32 length) { _lengths[column * _rowCount + row] = length; }
+
+    // Sets up a row of fields (GetColumnCount() of them) once, metadata holds one entry per column
+    void InitializeRow(Field* fields, QueryResultFieldMetadata const* metadata) const;
+
+    // Points the fields at the values of row, nothing is copied or decoded
+    void ReadRow(uint64 row, Field* fields) const;
+
+    [[nodiscard]] uint64 GetRowCount() const { return _rowCount; }
+    [[nodiscard]] uint32 GetColumnCount() const { return _columnCount; }
+    [[nodiscard]] std::size_t GetAllocatedSize() const { return _size; }
+
+private:
+    struct Column
+    {
+        std::size_t Offset;
+        uint32 Size;
+    };
+
+    std::unique_ptr<char[]> _arena;
+    Column* _columns{ nullptr };
+    uint32* _lengths{ nullptr };
+    char* _data{ nullptr };
+    std::size_t _size{ 0 };
+    uint64 _rowCount{ 0 };
+    uint32 _columnCount{ 0 };
+
+    PreparedResultColumns(PreparedResultColumns const& right) = delete;
+    PreparedResultColumns& operator=(PreparedResultColumns const& right) = delete;
+};
+
 class WH_DATABASE_API PreparedResultSet
 {
 public:
@@ -116,7 +189,7 @@ public:
         std::apply([this](Ts&... args)
         {
             uint8 index{ 0 };
-            ((args = _rows[uint32(_rowPosition) * _fieldCount + index].Get<Ts>(), index++), ...);
+            ((args = _currRow[index].Get<Ts>(), index++), ...);
         }, theTuple);
 
         return theTuple;
@@ -127,7 +200,8 @@ public:
 
 protected:
     std::vector<QueryResultFieldMetadata> _fieldMetadata;
-    std::vector<Field> _rows;
+    PreparedResultColumns _columns;
+    std::unique_ptr<Field[]> _currRow;
     uint64 _rowCount;
     uint64 _rowPosition{};
     uint32 _fieldCount;
@@ -138,7 +212,7 @@ private:
     MySQLResult* _metadataResult;    ///< Field metadata, returned by mysql_stmt_result_metadata
 
     void CleanUp();
-    bool _NextRow();
+    void ReadCurrentRow();
 
     void AssertRows(std::size_t sizeRows) const;
 
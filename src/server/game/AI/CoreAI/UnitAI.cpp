@@ -347,9 +347,9 @@ ThreatMgr& UnitAI::GetThreatMgr()
     return me->GetThreatMgr();
 }
 
-void UnitAI::SortByDistance(std::list<Unit*>& list, bool ascending)
+void UnitAI::SortByDistance(std::vector<Unit*>& list, bool ascending)
 {
-    list.sort(Warhead::ObjectDistanceOrderPred(me, ascending));
+    std::stable_sort(list.begin(), list.end(), Warhead::ObjectDistanceOrderPred(me, ascending));
 }
 
 //Enable PlayerAI when charmed
@@ -21,7 +21,9 @@
 #include "Containers.h"
 #include "Define.h"
 #include "Unit.h"
+#include <algorithm>
 #include <list>
+#include <vector>
 
 class Player;
 class Quest;
@@ -155,13 +157,8 @@ public:
     template <class PREDICATE>
     Unit* SelectTarget(SelectTargetMethod targetType, uint32 position, PREDICATE const& predicate)
     {
-        ThreatMgr& mgr = GetThreatMgr();
-        // shortcut: if we ignore the first <offset> elements, and there are at most <offset> elements, then we ignore ALL elements
-        if (mgr.GetThreatListSize() <= position)
-            return nullptr;
-
-        std::list<Unit*> targetList;
-        SelectTargetList(targetList, mgr.GetThreatListSize(), targetType, position, predicate);
+        std::vector<Unit*> targetList;
+        GetOrderedTargets(targetList, targetType, position, predicate);
 
         // maybe nothing fulfills the predicate
         if (targetList.empty())
@@ -199,71 +196,18 @@ public:
     template <class PREDICATE>
     void SelectTargetList(std::list<Unit*>& targetList, uint32 num, SelectTargetMethod targetType, uint32 position, PREDICATE const& predicate)
     {
-        targetList.clear();
-        ThreatMgr& mgr = GetThreatMgr();
-        // shortcut: we're gonna ignore the first <offset> elements, and there's at most <offset> elements, so we ignore them all - nothing to do here
-        if (mgr.GetThreatListSize() <= position)
-            return;
-
-        if (targetType == SelectTargetMethod::MaxDistance || targetType == SelectTargetMethod::MinDistance)
-        {
-            for (ThreatReference const* ref : mgr.GetUnsortedThreatList())
-            {
-                if (ref->IsOffline())
-                    continue;
-
-                targetList.push_back(ref->GetVictim());
-            }
-        }
-        else
-        {
-            Unit* currentVictim = mgr.GetCurrentVictim();
-            if (currentVictim)
-                targetList.push_back(currentVictim);
-
-            for (ThreatReference const* ref : mgr.GetSortedThreatList())
-            {
-                if (ref->IsOffline())
-                    continue;
-
-                Unit* thisTarget = ref->GetVictim();
-                if (thisTarget != currentVictim)
-                    targetList.push_back(thisTarget);
-            }
-        }
+        std::vector<Unit*> targets;
+        GetOrderedTargets(targets, targetType, position, predicate);
 
-        // shortcut: the list isn't gonna get any larger
-        if (targetList.size() <= position)
+        if (targets.size() > num)
         {
-            targetList.clear();
-            return;
+            if (targetType == SelectTargetMethod::Random)
+                Warhead::Containers::RandomResize(targets, num);
+            else
+                targets.resize(num);
         }
 
-        // right now, list is unsorted for DISTANCE types - re-sort by SelectTargetMethod::MaxDistance
-        if (targetType == SelectTargetMethod::MaxDistance || targetType == SelectTargetMethod::MinDistance)
-            SortByDistance(targetList, targetType == SelectTargetMethod::MinDistance);
-
-        // now the list is MAX sorted, reverse for MIN types
-        if (targetType == SelectTargetMethod::MinThreat)
-            targetList.reverse();
-
-        // ignore the first <offset> elements
-        while (position)
-        {
-            targetList.pop_front();
-            --position;
-        }
-
-        // then finally filter by predicate
-        targetList.remove_if([&predicate](Unit* target) { return !predicate(target); });
-
-        if (targetList.size() <= num)
-            return;
-
-        if (targetType == SelectTargetMethod::Random)
-            Warhead::Containers::RandomResize(targetList, num);
-        else
-            targetList.resize(num);
+        targetList.assign(targets.begin(), targets.end());
     }
 
     /**
@@ -334,7 +278,66 @@ public:
 
 private:
     ThreatMgr& GetThreatMgr();
-    void SortByDistance(std::list<Unit*>& list, bool ascending = true);
+    void SortByDistance(std::vector<Unit*>& list, bool ascending = true);
+
+    // Fills <targets> with the threat list targets in <targetType> order (the current victim first for threat orders),
+    // without the first <position> of them and the ones not satisfying <predicate>
+    template <class PREDICATE>
+    void GetOrderedTargets(std::vector<Unit*>& targets, SelectTargetMethod targetType, uint32 position, PREDICATE const& predicate)
+    {
+        ThreatMgr& mgr = GetThreatMgr();
+        // shortcut: we're gonna ignore the first <offset> elements, and there's at most <offset> elements, so we ignore them all - nothing to do here
+        if (mgr.GetThreatListSize() <= position)
+            return;
+
+        targets.reserve(std::size_t(mgr.GetThreatListSize()) + 1);
+
+        if (targetType == SelectTargetMethod::MaxDistance || targetType == SelectTargetMethod::MinDistance)
+        {
+            for (ThreatReference const* ref : mgr.GetUnsortedThreatList())
+            {
+                if (ref->IsOffline())
+                    continue;
+
+                targets.push_back(ref->GetVictim());
+            }
+        }
+        else
+        {
+            Unit* currentVictim = mgr.GetCurrentVictim();
+            if (currentVictim)
+                targets.push_back(currentVictim);
+
+            for (ThreatReference const* ref : mgr.GetSortedThreatList())
+            {
+                if (ref->IsOffline())
+                    continue;
+
+                Unit* thisTarget = ref->GetVictim();
+                if (thisTarget != currentVictim)
+                    targets.push_back(thisTarget);
+            }
+        }
+
+        // shortcut: the list isn't gonna get any larger
+        if (targets.size() <= position)
+        {
+            targets.clear();
+            return;
+        }
+
+        // right now, list is unsorted for DISTANCE types - re-sort by SelectTargetMethod::MaxDistance
+        if (targetType == SelectTargetMethod::MaxDistance || targetType == SelectTargetMethod::MinDistance)
+            SortByDistance(targets, targetType == SelectTargetMethod::MinDistance);
+
+        // now the list is MAX sorted, reverse for MIN types
+        if (targetType == SelectTargetMethod::MinThreat)
+            std::reverse(targets.begin(), targets.end());
+
+        // ignore the first <offset> elements, then filter by predicate
+        targets.erase(targets.begin(), targets.begin() + position);
+        std::erase_if(targets, [&predicate](Unit* target) { return !predicate(target); });
+    }
 };
 
 class WH_GAME_API PlayerAI : public UnitAI
@@ -56,6 +56,9 @@ SmartScript::SmartScript()
     mTemplate = SMARTAI_TEMPLATE_BASIC;
     mScriptType = SMART_SCRIPT_TYPE_CREATURE;
     isProcessingTimedActionList = false;
+    mTimersDueIn = 0;
+    mTimersSkipped = 0;
+    mTimersEngaged = false;
 
     // Xinef: Fix Combat Movement
     mActualCombatDist = 0;
@@ -75,6 +78,8 @@ SmartScript::~SmartScript()
 
 void SmartScript::OnReset()
 {
+    WakeTimers();
+
     // xinef: check if we allow phase reset
     if (AllowPhaseReset())
         SetPhase(0);
@@ -99,21 +104,54 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob)
 {
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
+    if (e == SMART_EVENT_LINK || e >= SMART_EVENT_AC_END)//special handling
+        return;
+
+    // bounds are read every step, an action may install new events
+    for (uint32 i = mEventsByTypeStart[e]; i < mEventsByTypeStart[e + 1]; ++i)
     {
-        SMART_EVENT eventType = SMART_EVENT((*i).GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
-            continue;
+        SmartScriptHolder& holder = mEvents[mEventsByType[i]];
+        ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
 
-        if (eventType == e)
-        {
-            ConditionList conds = sConditionMgr->GetConditionsForSmartEvent((*i).entryOrGuid, (*i).event_id, (*i).source_type);
-            ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
+        if (sConditionMgr->IsObjectMeetToConditions(info, GetConditions(holder)))
+            ProcessEvent(holder, unit, var0, var1, bvar, spell, gob);
+    }
+}
 
-            if (sConditionMgr->IsObjectMeetToConditions(info, conds))
-                ProcessEvent(*i, unit, var0, var1, bvar, spell, gob);
-        }
+ConditionList const& SmartScript::GetConditions(SmartScriptHolder& e)
+{
+    uint32 generation = sConditionMgr->GetGeneration();
+    if (e.conditionsGeneration != generation)
+    {
+        e.conditions = &sConditionMgr->GetSmartEventConditions(e.entryOrGuid, e.event_id, e.source_type);
+        e.conditionsGeneration = generation;
     }
+
+    return *e.conditions;
+}
+
+void SmartScript::IndexEvents()
+{
+    // counting sort by type, keeps the list order within a type
+    mEventsByTypeStart.fill(0);
+    for (SmartScriptHolder& holder : mEvents)
+    {
+        if (holder.GetEventType() < SMART_EVENT_AC_END)
+            ++mEventsByTypeStart[holder.GetEventType() + 1];
+
+        GetConditions(holder);
+    }
+
+    for (uint32 type = 1; type <= SMART_EVENT_AC_END; ++type)
+        mEventsByTypeStart[type] += mEventsByTypeStart[type - 1];
+
+    std::array<uint32, SMART_EVENT_AC_END> next;
+    std::copy(mEventsByTypeStart.begin(), mEventsByTypeStart.end() - 1, next.begin());
+
+    mEventsByType.resize(mEventsByTypeStart[SMART_EVENT_AC_END]);
+    for (uint32 i = 0; i < mEvents.size(); ++i)
+        if (mEvents[i].GetEventType() < SMART_EVENT_AC_END)
+            mEventsByType[next[mEvents[i].GetEventType()]++] = i;
 }
 
 void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob)
@@ -3044,10 +3082,9 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 void SmartScript::ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob)
 {
     // xinef: extended by selfs victim
-    ConditionList const conds = sConditionMgr->GetConditionsForSmartEvent(e.entryOrGuid, e.event_id, e.source_type);
     ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
 
-    if (sConditionMgr->IsObjectMeetToConditions(info, conds))
+    if (sConditionMgr->IsObjectMeetToConditions(info, GetConditions(e)))
     {
         ProcessAction(e, unit, var0, var1, bvar, spell, gob);
         RecalcTimer(e, min, max);
@@ -3750,6 +3787,9 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
     if (!e.active && e.GetEventType() != SMART_EVENT_LINK)
         return;
 
+    // timers may be changed from here on
+    WakeTimers();
+
     if ((e.event.event_phase_mask && !IsInPhase(e.event.event_phase_mask)) || ((e.event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE) && e.runOnce))
         return;
 
@@ -4552,16 +4592,7 @@ void SmartScript::RecalcTimer(SmartScriptHolder& e, uint32 min, uint32 max)
 
 void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
 {
-    if (e.GetEventType() == SMART_EVENT_LINK)
-        return;
-
-    if (e.event.event_phase_mask && !IsInPhase(e.event.event_phase_mask))
-        return;
-
-    if (e.GetEventType() == SMART_EVENT_UPDATE_IC && (!me || !me->IsEngaged()))
-        return;
-
-    if (e.GetEventType() == SMART_EVENT_UPDATE_OOC && (me && me->IsEngaged()))//can be used with me=nullptr (go script)
+    if (IsTimerPaused(e, me && me->IsEngaged()))
         return;
 
     if (e.timer < diff)
@@ -4587,78 +4618,81 @@ void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
         } // @TODO: Can't these be handled by the action themselves instead? Less expensive
 
         e.active = true;//activate events with cooldown
-        switch (e.GetEventType())//process ONLY timed events
-        {
-            case SMART_EVENT_NEAR_PLAYERS:
-            case SMART_EVENT_NEAR_PLAYERS_NEGATION:
-            case SMART_EVENT_NEAR_UNIT:
-            case SMART_EVENT_NEAR_UNIT_NEGATION:
-            case SMART_EVENT_UPDATE:
-            case SMART_EVENT_UPDATE_OOC:
-            case SMART_EVENT_UPDATE_IC:
-            case SMART_EVENT_HEALTH_PCT:
-            case SMART_EVENT_TARGET_HEALTH_PCT:
-            case SMART_EVENT_MANA_PCT:
-            case SMART_EVENT_TARGET_MANA_PCT:
-            case SMART_EVENT_RANGE:
-            case SMART_EVENT_AREA_RANGE:
-            case SMART_EVENT_VICTIM_CASTING:
-            case SMART_EVENT_AREA_CASTING:
-            case SMART_EVENT_FRIENDLY_HEALTH:
-            case SMART_EVENT_FRIENDLY_IS_CC:
-            case SMART_EVENT_FRIENDLY_MISSING_BUFF:
-            case SMART_EVENT_HAS_AURA:
-            case SMART_EVENT_TARGET_BUFFED:
-            case SMART_EVENT_IS_BEHIND_TARGET:
-            case SMART_EVENT_FRIENDLY_HEALTH_PCT:
-            case SMART_EVENT_DISTANCE_CREATURE:
-            case SMART_EVENT_DISTANCE_GAMEOBJECT:
-                {
-                    ProcessEvent(e);
-                    if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
+        if (IsTimedEvent(e.GetEventType()))//process ONLY timed events
+        {
+            ProcessEvent(e);
+            if (e.GetScriptType() == SMART_SCRIPT_TYPE_TIMED_ACTIONLIST)
+            {
+                e.enableTimed = false;//disable event if it is in an ActionList and was processed once
+                for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
+                {
+                    //find the first event which is not the current one and enable it
+                    if (i->event_id > e.event_id)
                     {
-                        e.enableTimed = false;//disable event if it is in an ActionList and was processed once
-                        for (SmartAIEventList::iterator i = mTimedActionList.begin(); i != mTimedActionList.end(); ++i)
-                        {
-                            //find the first event which is not the current one and enable it
-                            if (i->event_id > e.event_id)
-                            {
-                                i->enableTimed = true;
-                                break;
-                            }
-                        }
+                        i->enableTimed = true;
+                        break;
                     }
-                    break;
                 }
+            }
         }
     }
     else
         e.timer -= diff;
 }
 
-bool SmartScript::CheckTimer(SmartScriptHolder const& e) const
-{
-    return e.active;
-}
-
-void SmartScript::InstallEvents()
+bool SmartScript::IsTimedEvent(uint32 eventType)
 {
-    if (!mInstallEvents.empty())
+    switch (eventType)
     {
-        for (SmartAIEventList::iterator i = mInstallEvents.begin(); i != mInstallEvents.end(); ++i)
-            mEvents.push_back(*i);//must be before UpdateTimers
-
-        mInstallEvents.clear();
+        case SMART_EVENT_NEAR_PLAYERS:
+        case SMART_EVENT_NEAR_PLAYERS_NEGATION:
+        case SMART_EVENT_NEAR_UNIT:
+        case SMART_EVENT_NEAR_UNIT_NEGATION:
+        case SMART_EVENT_UPDATE:
+        case SMART_EVENT_UPDATE_OOC:
+        case SMART_EVENT_UPDATE_IC:
+        case SMART_EVENT_HEALTH_PCT:
+        case SMART_EVENT_TARGET_HEALTH_PCT:
+        case SMART_EVENT_MANA_PCT:
+        case SMART_EVENT_TARGET_MANA_PCT:
+        case SMART_EVENT_RANGE:
+        case SMART_EVENT_AREA_RANGE:
+        case SMART_EVENT_VICTIM_CASTING:
+        case SMART_EVENT_AREA_CASTING:
+        case SMART_EVENT_FRIENDLY_HEALTH:
+        case SMART_EVENT_FRIENDLY_IS_CC:
+        case SMART_EVENT_FRIENDLY_MISSING_BUFF:
+        case SMART_EVENT_HAS_AURA:
+        case SMART_EVENT_TARGET_BUFFED:
+        case SMART_EVENT_IS_BEHIND_TARGET:
+        case SMART_EVENT_FRIENDLY_HEALTH_PCT:
+        case SMART_EVENT_DISTANCE_CREATURE:
+        case SMART_EVENT_DISTANCE_GAMEOBJECT:
+            return true;
+        default:
+            return false;
     }
 }
 
-void SmartScript::OnUpdate(uint32 const diff)
+bool SmartScript::IsTimerPaused(SmartScriptHolder const& e, bool engaged) const
 {
-    if ((mScriptType == SMART_SCRIPT_TYPE_CREATURE || mScriptType == SMART_SCRIPT_TYPE_GAMEOBJECT) && !GetBaseObject())
-        return;
+    if (e.GetEventType() == SMART_EVENT_LINK)
+        return true;
 
-    InstallEvents();//before UpdateTimers
+    if (e.event.event_phase_mask && !IsInPhase(e.event.event_phase_mask))
+        return true;
+
+    if (e.GetEventType() == SMART_EVENT_UPDATE_IC && !engaged)
+        return true;
 
+    if (e.GetEventType() == SMART_EVENT_UPDATE_OOC && engaged)//can be used with me=nullptr (go script)
+        return true;
+
+    return false;
+}
+
+void SmartScript::UpdateTimers(uint32 diff)
+{
     for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
         UpdateTimer(*i, diff);
 
@@ -4689,6 +4723,109 @@ void SmartScript::OnUpdate(uint32 const diff)
     }
     if (needCleanup)
         mTimedActionList.clear();
+}
+
+uint32 SmartScript::GetTimersDueIn(bool engaged) const
+{
+    uint32 dueIn = std::numeric_limits<uint32>::max();
+
+    auto check = [this, engaged, &dueIn](SmartScriptHolder const& e)
+    {
+        // paused timers and expired ones of untimed events only wait
+        if (IsTimerPaused(e, engaged) || (e.active && !IsTimedEvent(e.GetEventType())))
+            return;
+
+        dueIn = std::min(dueIn, e.timer);
+    };
+
+    for (SmartScriptHolder const& e : mEvents)
+        check(e);
+
+    for (SmartScriptHolder const& e : mStoredEvents)
+        check(e);
+
+    bool timedActionEnabled = false;
+    for (SmartScriptHolder const& e : mTimedActionList)
+    {
+        if (e.enableTimed)
+        {
+            check(e);
+            timedActionEnabled = true;
+        }
+    }
+
+    // the finished list is cleared by the next walk
+    if (!mTimedActionList.empty() && !timedActionEnabled)
+        return 0;
+
+    return dueIn;
+}
+
+void SmartScript::WakeTimers()
+{
+    // walked again on the next update
+    mTimersDueIn = 0;
+
+    if (!mTimersSkipped)
+        return;
+
+    // nothing was due, the skipped time only counts down the running timers
+    uint32 skipped = std::exchange(mTimersSkipped, 0);
+    auto countDown = [this, skipped](SmartScriptHolder& e)
+    {
+        if (!IsTimerPaused(e, mTimersEngaged) && e.timer >= skipped)
+            e.timer -= skipped;
+    };
+
+    for (SmartScriptHolder& e : mEvents)
+        countDown(e);
+
+    for (SmartScriptHolder& e : mStoredEvents)
+        countDown(e);
+
+    for (SmartScriptHolder& e : mTimedActionList)
+        if (e.enableTimed)
+            countDown(e);
+}
+
+bool SmartScript::CheckTimer(SmartScriptHolder const& e) const
+{
+    return e.active;
+}
+
+void SmartScript::InstallEvents()
+{
+    if (!mInstallEvents.empty())
+    {
+        WakeTimers();
+
+        for (SmartAIEventList::iterator i = mInstallEvents.begin(); i != mInstallEvents.end(); ++i)
+            mEvents.push_back(*i);//must be before UpdateTimers
+
+        mInstallEvents.clear();
+        IndexEvents();
+    }
+}
+
+void SmartScript::OnUpdate(uint32 const diff)
+{
+    if ((mScriptType == SMART_SCRIPT_TYPE_CREATURE || mScriptType == SMART_SCRIPT_TYPE_GAMEOBJECT) && !GetBaseObject())
+        return;
+
+    InstallEvents();//before UpdateTimers
+
+    // the timers are only walked when one may be due, until then the time is summed up
+    if ((me && me->IsEngaged()) != mTimersEngaged)
+        WakeTimers();
+
+    if (diff <= mTimersDueIn - mTimersSkipped)
+        mTimersSkipped += diff;
+    else
+    {
+        UpdateTimers(std::exchange(mTimersSkipped, 0) + diff);
+        mTimersEngaged = me && me->IsEngaged();
+        mTimersDueIn = GetTimersDueIn(mTimersEngaged);
+    }
 
     if (!mRemIDs.empty())
     {
@@ -4747,6 +4884,8 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger c
         }
         mEvents.push_back((*i));//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
+
+    IndexEvents();
 }
 
 void SmartScript::GetScript()
@@ -4785,6 +4924,8 @@ void SmartScript::GetScript()
 
 void SmartScript::OnInitialize(WorldObject* obj, AreaTrigger const* at)
 {
+    WakeTimers();
+
     if (obj)//handle object based scripts
     {
         switch (obj->GetTypeId())
@@ -4969,6 +5110,8 @@ Unit* SmartScript::DoFindClosestFriendlyInRange(float range, bool playerOnly) co
 
 void SmartScript::SetScript9(SmartScriptHolder& e, uint32 entry)
 {
+    WakeTimers();
+
     //do NOT clear mTimedActionList if it's being iterated because it will invalidate the iterator and delete
     // any SmartScriptHolder contained like the "e" parameter passed to this function
     if (isProcessingTimedActionList)
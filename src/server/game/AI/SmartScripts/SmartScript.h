@@ -20,6 +20,7 @@
 
 #include "GridNotifiers.h"
 #include "SmartScriptMgr.h"
+#include <array>
 
 class WH_GAME_API SmartScript
 {
@@ -139,9 +140,16 @@ private:
     bool IsInPhase(uint32 p) const;
 
     SmartAIEventList mEvents;
+    std::vector<uint32> mEventsByType;                                  // positions in mEvents grouped by event type
+    std::array<uint32, SMART_EVENT_AC_END + 1> mEventsByTypeStart{};    // first entry of each type in mEventsByType
     SmartAIEventList mInstallEvents;
     SmartAIEventList mTimedActionList;
     bool isProcessingTimedActionList;
+
+    // Timers are only walked once one may be due, see GetTimersDueIn
+    uint32 mTimersDueIn;        // time after the last walk until then
+    uint32 mTimersSkipped;      // time since the last walk not counted down yet
+    bool mTimersEngaged;        // engaged state of the skipped time
     Creature* me;
     ObjectGuid meOrigGUID;
     GameObject* go;
@@ -176,6 +184,17 @@ private:
 
     SMARTAI_TEMPLATE mTemplate;
     void InstallEvents();
+    void IndexEvents();
+
+    static bool IsTimedEvent(uint32 eventType);
+    [[nodiscard]] bool IsTimerPaused(SmartScriptHolder const& e, bool engaged) const;
+    void UpdateTimers(uint32 diff);
+    // Time until a timer may do more than count down
+    [[nodiscard]] uint32 GetTimersDueIn(bool engaged) const;
+    // Counts the skipped time down, must be called before timers or the phase change outside of a walk
+    void WakeTimers();
+
+    ConditionList const& GetConditions(SmartScriptHolder& e);
 
     void RemoveStoredEvent(uint32 id)
     {
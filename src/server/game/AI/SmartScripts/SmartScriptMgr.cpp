@@ -21,6 +21,7 @@
 #include "SmartScriptMgr.h"
 #include "CellImpl.h"
 #include "CreatureTextMgr.h"
+#include "DBCacheMgr.h"
 #include "DatabaseEnv.h"
 #include "GameEventMgr.h"
 #include "GridDefines.h"
@@ -133,8 +134,7 @@ void SmartAIMgr::LoadSmartAIFromDB()
     for (uint8 i = 0; i < SMART_SCRIPT_TYPE_MAX; i++)
         mEventMap[i].clear();  //Drop Existing SmartAI List
 
-    WorldDatabasePreparedStatement stmt = WorldDatabase.GetPreparedStatement(WORLD_SEL_SMART_SCRIPTS);
-    PreparedQueryResult result = WorldDatabase.Query(stmt);
+    QueryResult result = sDBCacheMgr->GetResult(DBCacheTable::SmartScripts);
 
     if (!result)
     {
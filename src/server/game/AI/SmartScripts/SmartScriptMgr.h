@@ -19,6 +19,7 @@
 #define WARHEAD_SMARTSCRIPTMGR_H
 
 #include "Common.h"
+#include "ConditionMgr.h"
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "DBCStores.h"
@@ -1887,7 +1888,7 @@ struct SmartScriptHolder
 {
     SmartScriptHolder() : entryOrGuid(0), source_type(SMART_SCRIPT_TYPE_CREATURE)
         , event_id(0), link(0), event(), action(), target(), timer(0), active(false), runOnce(false)
-        , enableTimed(false) {}
+        , enableTimed(false), conditions(nullptr), conditionsGeneration(0) {}
 
     int32 entryOrGuid;
     SmartScriptType source_type;
@@ -1908,6 +1909,10 @@ public:
     bool active;
     bool runOnce;
     bool enableTimed;
+
+    // stored conditions of the event, resolved again when the conditions are reloaded
+    ConditionList const* conditions;
+    uint32 conditionsGeneration;
 };
 
 typedef std::unordered_map<uint32, WayPoint*> WPPath;
@@ -16,12 +16,17 @@
  */
 
 #include "DBCacheMgr.h"
+#include "Config.h"
+#include "DBCacheSnapshot.h"
 #include "DatabaseEnv.h"
 #include "GameConfig.h"
 #include "Log.h"
 #include "StopWatch.h"
 #include "Util.h"
 
+DBCacheMgr::DBCacheMgr() = default;
+DBCacheMgr::~DBCacheMgr() = default;
+
 /*static*/ DBCacheMgr* DBCacheMgr::instance()
 {
     static DBCacheMgr instance;
@@ -38,6 +43,7 @@ void DBCacheMgr::Initialize()
     _isEnableWaitAtAdd = CONF_GET_BOOL("DBCache.WaitAtAdd.Enable");
 
     InitializeDefines();
+    InitializeSnapshot();
     InitializeQuery();
 
     LOG_INFO("server.loading", ">> Initialized database cache in {}", sw);
@@ -62,6 +68,10 @@ void DBCacheMgr::AddQuery(DBCacheTable index)
         return;
     }
 
+    // replayed from the snapshot in GetResult
+    if (_snapshot && _snapshot->Contains(sql))
+        return;
+
     auto task = new BasicStatementTask(sql, true);
     auto result = task->GetFuture();
     WorldDatabase.Enqueue(task);
@@ -69,12 +79,13 @@ void DBCacheMgr::AddQuery(DBCacheTable index)
     if (_isEnableWaitAtAdd)
         result.wait();
 
+    std::lock_guard<std::mutex> guard(_queryListLock);
     _queryList.emplace(index, std::move(result));
 }
 
 QueryResult DBCacheMgr::GetResult(DBCacheTable index)
 {
-    if (!_isEnableAsyncLoad)
+    if (!_isEnableAsyncLoad || _snapshot)
     {
         auto sql{ GetStringQuery(index) };
         if (sql.empty())
@@ -83,11 +94,32 @@ QueryResult DBCacheMgr::GetResult(DBCacheTable index)
             return nullptr;
         }
 
-        return WorldDatabase.Query(sql);
+        if (_snapshot)
+        {
+            QueryResult result;
+            if (_snapshot->Replay(sql, result))
+                return result;
+        }
+
+        if (!_isEnableAsyncLoad)
+            return Query(sql);
     }
 
-    auto const& itr = _queryList.find(index);
-    if (itr == _queryList.end())
+    QueryResultFuture future;
+
+    {
+        // loaders may run in parallel at startup
+        std::lock_guard<std::mutex> guard(_queryListLock);
+
+        auto const& itr = _queryList.find(index);
+        if (itr != _queryList.end())
+        {
+            future = std::move(itr->second);
+            _queryList.erase(itr);
+        }
+    }
+
+    if (!future.valid())
     {
         LOG_ERROR("db.async", "Not found query with index {}", AsUnderlyingType(index));
 
@@ -98,13 +130,75 @@ QueryResult DBCacheMgr::GetResult(DBCacheTable index)
             return nullptr;
         }
 
+        return Query(sql);
+    }
+
+    future.wait();
+
+    if (_snapshot)
+        return _snapshot->Record(GetStringQuery(index), future.get());
+
+    return future.get();
+}
+
+QueryResult DBCacheMgr::Query(std::string_view sql)
+{
+    if (!_snapshot)
         return WorldDatabase.Query(sql);
+
+    QueryResult result;
+    if (_snapshot->Replay(sql, result))
+        return result;
+
+    return _snapshot->Record(sql, WorldDatabase.Query(sql));
+}
+
+void DBCacheMgr::InitializeSnapshot()
+{
+    if (!CONF_GET_BOOL("DBCache.Snapshot.Enable"))
+        return;
+
+    _snapshotPath = CONF_GET_STR("DBCache.Snapshot.File");
+    if (_snapshotPath.empty())
+        _snapshotPath = sConfigMgr->GetOption<std::string>("DataDir", "./") + "/world.snapshot";
+
+    StopWatch sw;
+
+    uint64 checksum = DBCacheSnapshot::GetWorldChecksum();
+    if (!checksum)
+    {
+        LOG_ERROR("server.loading", ">> Can't checksum the world database, snapshot disabled");
+        return;
+    }
+
+    LOG_INFO("server.loading", ">> World database checksum {:016X} in {}", checksum, sw);
+
+    sw.Reset();
+
+    _snapshot = std::make_unique<DBCacheSnapshot>(checksum);
+
+    if (_snapshot->Load(_snapshotPath))
+        LOG_INFO("server.loading", ">> Loaded world snapshot '{}' with {} queries in {}", _snapshotPath, _snapshot->GetQueryCount(), sw);
+    else
+        LOG_INFO("server.loading", ">> World snapshot '{}' is missing or outdated, it will be rebuilt", _snapshotPath);
+}
+
+void DBCacheMgr::FinishSnapshot()
+{
+    if (!_snapshot)
+        return;
+
+    if (_snapshot->IsModified())
+    {
+        StopWatch sw;
+
+        if (_snapshot->Save(_snapshotPath))
+            LOG_INFO("server.loading", ">> Saved world snapshot '{}' with {} queries in {}", _snapshotPath, _snapshot->GetQueryCount(), sw);
+        else
+            LOG_ERROR("server.loading", ">> Can't save world snapshot '{}'", _snapshotPath);
     }
 
-    itr->second.wait();
-    auto result{ itr->second.get() };
-    _queryList.erase(index);
-    return result;
+    _snapshot.reset();
 }
 
 std::string_view DBCacheMgr::GetStringQuery(DBCacheTable index)
@@ -257,6 +351,7 @@ void DBCacheMgr::InitializeQuery()
     AddQuery(DBCacheTable::PlayerFactionchangeTitles);
     AddQuery(DBCacheTable::PlayerFactionchangeQuest);
     AddQuery(DBCacheTable::SpellScriptNames);
+    AddQuery(DBCacheTable::SmartScripts);
     AddQuery(DBCacheTable::CreatureTextLocale);
     AddQuery(DBCacheTable::BattlegroundTemplate);
     AddQuery(DBCacheTable::OutdoorpvpTemplate);
@@ -20,15 +20,19 @@
 
 #include "DBCacheStrings.h"
 #include "DatabaseEnvFwd.h"
+#include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 
+class DBCacheSnapshot;
+
 class WH_GAME_API DBCacheMgr
 {
 public:
-    DBCacheMgr() = default;
-    ~DBCacheMgr() = default;
+    DBCacheMgr();
+    ~DBCacheMgr();
 
     static DBCacheMgr* instance();
 
@@ -37,9 +41,16 @@ public:
     void AddQuery(DBCacheTable index);
     QueryResult GetResult(DBCacheTable index);
 
+    // World query of a startup loader, served from the snapshot while it is in use
+    QueryResult Query(std::string_view sql);
+
+    // Saves the snapshot if queries were added to it and stops using it, runtime reloads go to the database
+    void FinishSnapshot();
+
 private:
     void InitializeDefines();
     void InitializeQuery();
+    void InitializeSnapshot();
 
     //
     void InitGameLocaleStrings();
@@ -57,9 +68,12 @@ private:
     std::string_view GetStringQuery(DBCacheTable index);
 
     std::unordered_map<DBCacheTable, QueryResultFuture> _queryList;
+    std::mutex _queryListLock;
     std::unordered_map<DBCacheTable, std::string> _queryStrings;
     bool _isEnableAsyncLoad{};
     bool _isEnableWaitAtAdd{};
+    std::unique_ptr<DBCacheSnapshot> _snapshot;
+    std::string _snapshotPath;
 
     DBCacheMgr(DBCacheMgr const&) = delete;
     DBCacheMgr(DBCacheMgr&&) = delete;
@@ -0,0 +1,362 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include "DBCacheSnapshot.h"
+#include "DatabaseEnv.h"
+#include "Log.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace
+{
+    constexpr uint32 SNAPSHOT_MAGIC = 0x53445757;       // 'WWDS'
+    constexpr uint32 SNAPSHOT_VERSION = 1;
+    constexpr uint64 HASH_SEED = 14695981039346656037ULL;
+    constexpr uint64 HASH_PRIME = 1099511628211ULL;
+
+    inline uint64 Mix(uint64 hash, std::string_view value)
+    {
+        for (char c : value)
+            hash = (hash ^ uint8(c)) * HASH_PRIME;
+
+        // separator, "ab" + "c" must not hash like "a" + "bc"
+        return (hash ^ 0xFF) * HASH_PRIME;
+    }
+
+    class SnapshotReader
+    {
+    public:
+        SnapshotReader(char const* data, std::size_t size) : _data(data), _size(size), _offset(0) { }
+
+        template<typename T>
+        bool Read(T& value)
+        {
+            if (_size - _offset < sizeof(T))
+                return false;
+
+            memcpy(&value, _data + _offset, sizeof(T));
+            _offset += sizeof(T);
+            return true;
+        }
+
+        bool Read(std::string& value)
+        {
+            uint32 length;
+            if (!Read(length) || _size - _offset < length)
+                return false;
+
+            value.assign(_data + _offset, length);
+            _offset += length;
+            return true;
+        }
+
+        bool Read(std::vector<char>& value, uint64 length)
+        {
+            if (_size - _offset < length)
+                return false;
+
+            value.assign(_data + _offset, _data + _offset + length);
+            _offset += std::size_t(length);
+            return true;
+        }
+
+        [[nodiscard]] bool IsEnd() const { return _offset == _size; }
+
+    private:
+        char const* _data;
+        std::size_t _size;
+        std::size_t _offset;
+    };
+
+    class SnapshotWriter
+    {
+    public:
+        explicit SnapshotWriter(FILE* file) : _file(file), _good(true) { }
+
+        template<typename T>
+        void Write(T const& value) { Write(&value, sizeof(T)); }
+
+        void Write(std::string_view value)
+        {
+            Write(uint32(value.size()));
+            Write(value.data(), value.size());
+        }
+
+        void Write(void const* data, std::size_t size)
+        {
+            if (_good && size)
+                _good = fwrite(data, size, 1, _file) == 1;
+        }
+
+        [[nodiscard]] bool IsGood() const { return _good; }
+
+    private:
+        FILE* _file;
+        bool _good;
+    };
+
+    // Walks every value once, replay trusts the layout afterwards
+    bool IsValidRows(ResultSetRows const& rows)
+    {
+        std::size_t offset = 0;
+        std::size_t size = rows.Data.size();
+
+        for (uint64 row = 0; row < rows.RowCount; ++row)
+        {
+            for (std::size_t field = 0; field < rows.Fields.size(); ++field)
+            {
+                uint32 length;
+                if (size - offset < sizeof(length))
+                    return false;
+
+                memcpy(&length, rows.Data.data() + offset, sizeof(length));
+                offset += sizeof(length);
+
+                if (length == ResultSetRows::NULL_VALUE)
+                    continue;
+
+                if (size - offset < std::size_t(length) + 1 || rows.Data[offset + length] != '\0')
+                    return false;
+
+                offset += std::size_t(length) + 1;
+            }
+        }
+
+        return offset == size;
+    }
+}
+
+DBCacheSnapshot::DBCacheSnapshot(uint64 key) : _key(key)
+{
+}
+
+DBCacheSnapshot::~DBCacheSnapshot() = default;
+
+bool DBCacheSnapshot::Load(std::string const& path)
+{
+    std::error_code error;
+    auto fileSize = std::filesystem::file_size(path, error);
+    if (error)
+        return false;
+
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f)
+        return false;
+
+    std::vector<char> buffer(fileSize);
+    bool read = buffer.empty() || fread(buffer.data(), buffer.size(), 1, f) == 1;
+    fclose(f);
+
+    if (!read)
+        return false;
+
+    SnapshotReader reader(buffer.data(), buffer.size());
+
+    uint32 magic, version, queryCount;
+    uint64 key;
+
+    if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(key) || !reader.Read(queryCount))
+        return false;
+
+    if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION || key != _key)
+        return false;
+
+    std::unordered_map<std::string, std::shared_ptr<ResultSetRows const>> queries;
+    queries.reserve(queryCount);
+
+    for (uint32 i = 0; i < queryCount; ++i)
+    {
+        std::string sql;
+        uint32 fieldCount;
+
+        if (!reader.Read(sql) || !reader.Read(fieldCount))
+            return false;
+
+        auto rows = std::make_shared<ResultSetRows>();
+        rows->Fields.resize(fieldCount);
+
+        for (QueryResultFieldMetadata& meta : rows->Fields)
+        {
+            uint8 type;
+
+            if (!reader.Read(meta.TableName) || !reader.Read(meta.TableAlias) || !reader.Read(meta.Name) ||
+                !reader.Read(meta.Alias) || !reader.Read(meta.TypeName) || !reader.Read(meta.Index) || !reader.Read(type))
+                return false;
+
+            meta.Type = DatabaseFieldTypes(type);
+        }
+
+        uint64 dataSize;
+        if (!reader.Read(rows->RowCount) || !reader.Read(dataSize) || !reader.Read(rows->Data, dataSize))
+            return false;
+
+        if (!IsValidRows(*rows))
+            return false;
+
+        queries.emplace(std::move(sql), std::move(rows));
+    }
+
+    if (!reader.IsEnd())
+        return false;
+
+    std::lock_guard<std::mutex> guard(_lock);
+    _queries = std::move(queries);
+    _modified = false;
+    return true;
+}
+
+bool DBCacheSnapshot::Save(std::string const& path) const
+{
+    // written aside and renamed, a crash while saving leaves the old image
+    std::string tmpPath = path + ".tmp";
+    FILE* f = fopen(tmpPath.c_str(), "wb");
+    if (!f)
+        return false;
+
+    SnapshotWriter writer(f);
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        writer.Write(SNAPSHOT_MAGIC);
+        writer.Write(SNAPSHOT_VERSION);
+        writer.Write(_key);
+        writer.Write(uint32(_queries.size()));
+
+        for (auto const& [sql, rows] : _queries)
+        {
+            writer.Write(std::string_view(sql));
+            writer.Write(uint32(rows->Fields.size()));
+
+            for (QueryResultFieldMetadata const& meta : rows->Fields)
+            {
+                writer.Write(std::string_view(meta.TableName));
+                writer.Write(std::string_view(meta.TableAlias));
+                writer.Write(std::string_view(meta.Name));
+                writer.Write(std::string_view(meta.Alias));
+                writer.Write(std::string_view(meta.TypeName));
+                writer.Write(meta.Index);
+                writer.Write(uint8(meta.Type));
+            }
+
+            writer.Write(rows->RowCount);
+            writer.Write(uint64(rows->Data.size()));
+            writer.Write(rows->Data.data(), rows->Data.size());
+        }
+    }
+
+    bool written = (fclose(f) == 0) && writer.IsGood();
+
+    std::error_code error;
+    if (written)
+        std::filesystem::rename(tmpPath, path, error);
+
+    if (!written || error)
+    {
+        std::filesystem::remove(tmpPath, error);
+        return false;
+    }
+
+    return true;
+}
+
+bool DBCacheSnapshot::Contains(std::string_view sql) const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _queries.contains(std::string(sql));
+}
+
+bool DBCacheSnapshot::Replay(std::string_view sql, QueryResult& result) const
+{
+    std::shared_ptr<ResultSetRows const> rows;
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        auto itr = _queries.find(std::string(sql));
+        if (itr == _queries.end())
+            return false;
+
+        rows = itr->second;
+    }
+
+    result = ResultSet::FromRows(std::move(rows));
+    return true;
+}
+
+QueryResult DBCacheSnapshot::Record(std::string_view sql, QueryResult result)
+{
+    // empty and failed queries look the same, both are cheap to run again
+    if (!result)
+        return nullptr;
+
+    std::shared_ptr<ResultSetRows const> rows = result->TakeRows();
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _queries[std::string(sql)] = rows;
+        _modified = true;
+    }
+
+    return ResultSet::FromRows(std::move(rows));
+}
+
+std::size_t DBCacheSnapshot::GetQueryCount() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _queries.size();
+}
+
+/*static*/ uint64 DBCacheSnapshot::GetWorldChecksum()
+{
+    QueryResult tables = WorldDatabase.Query("SELECT TABLE_NAME FROM information_schema.TABLES WHERE TABLE_SCHEMA = DATABASE() AND TABLE_TYPE = 'BASE TABLE' ORDER BY TABLE_NAME");
+    if (!tables)
+        return 0;
+
+    std::string sql = "CHECKSUM TABLE ";
+
+    do
+    {
+        if (sql.back() != ' ')
+            sql += ", ";
+
+        sql += '`';
+        sql += tables->Fetch()[0].Get<std::string_view>();
+        sql += '`';
+    } while (tables->NextRow());
+
+    // the server scans the tables, no rows are sent
+    QueryResult checksums = WorldDatabase.Query(std::string_view(sql));
+    if (!checksums)
+        return 0;
+
+    uint64 hash = Mix(HASH_SEED, std::to_string(SNAPSHOT_VERSION));
+
+    do
+    {
+        auto fields = checksums->Fetch();
+        hash = Mix(hash, fields[0].Get<std::string_view>());
+        hash = Mix(hash, fields[1].IsNull() ? "NULL" : std::to_string(fields[1].Get<uint64>()));
+    } while (checksums->NextRow());
+
+    return hash;
+}
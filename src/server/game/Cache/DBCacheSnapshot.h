@@ -0,0 +1,69 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WARHEAD_DB_CACHE_SNAPSHOT_H_
+#define WARHEAD_DB_CACHE_SNAPSHOT_H_
+
+#include "DatabaseEnvFwd.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+struct ResultSetRows;
+
+/*
+  On-disk image of the world queries run at startup, keyed by their sql.
+  The image is only used while its key matches the world database checksum, queries missing
+  from it are recorded and the image is rewritten once the world finished loading.
+*/
+class WH_GAME_API DBCacheSnapshot
+{
+public:
+    explicit DBCacheSnapshot(uint64 key);
+    ~DBCacheSnapshot();
+
+    // Returns false if the file is missing, damaged or made for another key
+    bool Load(std::string const& path);
+    bool Save(std::string const& path) const;
+
+    [[nodiscard]] bool Contains(std::string_view sql) const;
+
+    // Returns true and sets result (nullptr for an empty query) if the query is in the image
+    bool Replay(std::string_view sql, QueryResult& result) const;
+
+    // Stores the rows of result, returns a result positioned on the same first row
+    QueryResult Record(std::string_view sql, QueryResult result);
+
+    [[nodiscard]] bool IsModified() const { return _modified; }
+    [[nodiscard]] std::size_t GetQueryCount() const;
+
+    // Checksum of every table of the world database
+    static uint64 GetWorldChecksum();
+
+private:
+    uint64 _key;
+    std::unordered_map<std::string, std::shared_ptr<ResultSetRows const>> _queries;
+    mutable std::mutex _lock;
+    bool _modified{ false };
+
+    DBCacheSnapshot(DBCacheSnapshot const&) = delete;
+    DBCacheSnapshot& operator=(DBCacheSnapshot const&) = delete;
+};
+
+#endif
@@ -84,6 +84,7 @@ enum class DBCacheTable : std::size_t
     ScriptNames,
     AreatriggerScripts,
     SpellScriptNames,
+    SmartScripts,
 
     // Gossip
     NpcText,
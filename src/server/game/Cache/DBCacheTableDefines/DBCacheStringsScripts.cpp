@@ -48,4 +48,9 @@ void DBCacheMgr::InitScriptStrings()
                                                      "SELECT DISTINCT(script) FROM instance_template WHERE script <> ''");
     _queryStrings.emplace(DBCacheTable::AreatriggerScripts, "SELECT entry, ScriptName FROM areatrigger_scripts");
     _queryStrings.emplace(DBCacheTable::SpellScriptNames, "SELECT spell_id, ScriptName FROM spell_script_names");
+    _queryStrings.emplace(DBCacheTable::SmartScripts, "SELECT entryorguid, source_type, id, link, event_type, event_phase_mask, event_chance, event_flags, "
+                                                      "event_param1, event_param2, event_param3, event_param4, event_param5, event_param6, "
+                                                      "action_type, action_param1, action_param2, action_param3, action_param4, action_param5, action_param6, "
+                                                      "target_type, target_param1, target_param2, target_param3, target_param4, target_x, target_y, target_z, target_o "
+                                                      "FROM smart_scripts ORDER BY entryorguid, source_type, id, link");
 }
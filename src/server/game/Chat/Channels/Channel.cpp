@@ -957,16 +957,18 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
 
 void Channel::SendToAll(WorldPacket* data, ObjectGuid guid)
 {
+    SharedWorldPacket sharedData(*data);
     for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
         if (!guid || !i->second.plrPtr->GetSocial()->HasIgnore(guid))
-            i->second.plrPtr->GetSession()->SendPacket(data);
+            i->second.plrPtr->GetSession()->SendPacket(sharedData);
 }
 
 void Channel::SendToAllButOne(WorldPacket* data, ObjectGuid who)
 {
+    SharedWorldPacket sharedData(*data);
     for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
         if (i->first != who)
-            i->second.plrPtr->GetSession()->SendPacket(data);
+            i->second.plrPtr->GetSession()->SendPacket(sharedData);
 }
 
 void Channel::SendToOne(WorldPacket* data, ObjectGuid who)
@@ -977,8 +979,9 @@ void Channel::SendToOne(WorldPacket* data, ObjectGuid who)
 
 void Channel::SendToAllWatching(WorldPacket* data)
 {
+    SharedWorldPacket sharedData(*data);
     for (PlayersWatchingContainer::const_iterator i = playersWatchingStore.begin(); i != playersWatchingStore.end(); ++i)
-        (*i)->GetSession()->SendPacket(data);
+        (*i)->GetSession()->SendPacket(sharedData);
 }
 
 void Channel::Voice(ObjectGuid /*guid1*/, ObjectGuid /*guid2*/)
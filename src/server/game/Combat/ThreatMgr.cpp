@@ -304,11 +304,26 @@ void ThreatContainer::ModifyThreatByPercent(Unit* victim, int32 percent)
 
 //============================================================
 // Check if the list is dirty and sort if necessary
+// Between two updates only a few refs change their threat or get added, so the list is
+// nearly sorted and an insertion sort moves just those. Stable like the full sort was.
 
 void ThreatContainer::update()
 {
     if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(Warhead::ThreatOrderPred());
+    {
+        Warhead::ThreatOrderPred pred;
+
+        for (auto itr = std::next(iThreatList.begin()); itr != iThreatList.end(); ++itr)
+        {
+            if (!pred(*itr, *std::prev(itr)))
+                continue;
+
+            HostileReference* ref = *itr;
+            auto dest = std::upper_bound(iThreatList.begin(), itr, ref, pred);
+            std::move_backward(dest, itr, std::next(itr));
+            *dest = ref;
+        }
+    }
 
     iDirty = false;
 }
@@ -657,8 +672,9 @@ void ThreatMgr::ResetAllThreat()
     if (threatList.empty())
         return;
 
-    for (ThreatContainer::StorageType::iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
-        (*itr)->SetThreat(0);
+    // by index, SetThreat may append the owner of a pet and reallocate the list
+    for (std::size_t i = 0; i < threatList.size(); ++i)
+        threatList[i]->SetThreat(0);
 
     setDirty(true);
 }
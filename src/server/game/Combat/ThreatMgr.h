@@ -23,7 +23,8 @@
 #include "Reference.h"
 #include "SharedDefines.h"
 #include "UnitEvents.h"
-#include <list>
+#include <algorithm>
+#include <vector>
 
 //==============================================================
 
@@ -144,7 +145,8 @@ class WH_GAME_API ThreatContainer
     friend class ThreatMgr;
 
 public:
-    typedef std::list<HostileReference*> StorageType;
+    // Sorted by threat (highest first) up to the last update(), refs are appended and keep their place until then
+    typedef std::vector<HostileReference*> StorageType;
 
     ThreatContainer() = default;
 
@@ -178,7 +180,10 @@ public:
 private:
     void remove(HostileReference* hostileRef)
     {
-        iThreatList.remove(hostileRef);
+        // keeps the order of the others, the list stays (almost) sorted
+        auto itr = std::find(iThreatList.begin(), iThreatList.end(), hostileRef);
+        if (itr != iThreatList.end())
+            iThreatList.erase(itr);
     }
 
     void addReference(HostileReference* hostileRef)
@@ -224,8 +229,8 @@ public:
     [[nodiscard]] bool isThreatListEmpty() const { return iThreatContainer.empty(); }
     [[nodiscard]] bool areThreatListsEmpty() const { return iThreatContainer.empty() && iThreatOfflineContainer.empty(); }
 
-    [[nodiscard]] Warhead::IteratorPair<std::list<ThreatReference*>::const_iterator> GetSortedThreatList() const { auto& list = iThreatContainer.GetThreatList(); return { list.cbegin(), list.cend() }; }
-    [[nodiscard]] Warhead::IteratorPair<std::list<ThreatReference*>::const_iterator> GetUnsortedThreatList() const { return GetSortedThreatList(); }
+    [[nodiscard]] Warhead::IteratorPair<ThreatContainer::StorageType::const_iterator> GetSortedThreatList() const { auto& list = iThreatContainer.GetThreatList(); return { list.cbegin(), list.cend() }; }
+    [[nodiscard]] Warhead::IteratorPair<ThreatContainer::StorageType::const_iterator> GetUnsortedThreatList() const { return GetSortedThreatList(); }
 
     void processThreatEvent(ThreatRefStatusChangeEvent* threatRefStatusChangeEvent);
 
@@ -258,8 +263,10 @@ public:
         if (threatList.empty())
             return;
 
-        for (auto& ref : threatList)
+        // by index, SetThreat may append the owner of a pet and reallocate the list
+        for (std::size_t i = 0; i < threatList.size(); ++i)
         {
+            HostileReference* ref = threatList[i];
             if (predicate(ref->getTarget()))
             {
                 ref->SetThreat(0);
@@ -986,18 +986,25 @@ ConditionList ConditionMgr::GetConditionsForVehicleSpell(uint32 creatureId, uint
 
 ConditionList ConditionMgr::GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType)
 {
-    ConditionList                                cond;
+    return GetSmartEventConditions(entryOrGuid, eventId, sourceType);
+}
+
+ConditionList const& ConditionMgr::GetSmartEventConditions(int32 entryOrGuid, uint32 eventId, uint32 sourceType) const
+{
+    static ConditionList const noConditions;
+
     SmartEventConditionContainer::const_iterator itr = SmartEventConditionStore.find(std::make_pair(entryOrGuid, sourceType));
     if (itr != SmartEventConditionStore.end())
     {
         ConditionTypeContainer::const_iterator i = (*itr).second.find(eventId + 1);
         if (i != (*itr).second.end())
         {
-            cond = (*i).second;
             LOG_DEBUG("condition", "GetConditionsForSmartEvent: found conditions for Smart Event entry or guid {} event_id {}", entryOrGuid, eventId);
+            return (*i).second;
         }
     }
-    return cond;
+
+    return noConditions;
 }
 
 ConditionList ConditionMgr::GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId)
@@ -1028,6 +1035,7 @@ void ConditionMgr::LoadConditions(bool isReload)
     StopWatch sw;
 
     Clean();
+    ++_generation;
 
     // must clear all custom handled cases (groupped types) before reload
     if (isReload)
@@ -263,9 +263,14 @@ public:
     ConditionList GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry);
     ConditionList GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId);
     ConditionList GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType);
+    // Same as above without the copy, the list stays valid until the generation changes
+    [[nodiscard]] ConditionList const& GetSmartEventConditions(int32 entryOrGuid, uint32 eventId, uint32 sourceType) const;
     ConditionList GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId);
     ConditionList GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId);
 
+    // Changes every time the conditions are (re)loaded
+    [[nodiscard]] uint32 GetGeneration() const { return _generation; }
+
 private:
     bool isSourceTypeValid(Condition* cond);
     bool addToLootTemplate(Condition* cond, LootTemplate* loot);
@@ -283,6 +288,8 @@ private:
     CreatureSpellConditionContainer   SpellClickEventConditionStore;
     NpcVendorConditionContainer       NpcVendorConditionContainerStore;
     SmartEventConditionContainer      SmartEventConditionStore;
+
+    uint32 _generation{ 1 };
 };
 
 #define sConditionMgr ConditionMgr::instance()
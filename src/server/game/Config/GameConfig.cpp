@@ -281,6 +281,13 @@ void GameConfig::CheckOptions(bool reload /*= false*/)
         SetOption<int32>("Compression", 1);
     }
 
+    tempIntOption = CONF_GET_INT("Compression.UpdateObject.CreateLevel");
+    if (tempIntOption < 1 || tempIntOption > 9)
+    {
+        LOG_ERROR("server.loading", "Compression.UpdateObject.CreateLevel ({}) must be in range 1..9. Using default compression level (1).", tempIntOption);
+        SetOption<int32>("Compression.UpdateObject.CreateLevel", 1);
+    }
+
     tempIntOption = CONF_GET_INT("PlayerSave.Stats.MinLevel");
     if (tempIntOption > MAX_LEVEL)
     {
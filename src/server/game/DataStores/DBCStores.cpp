@@ -20,6 +20,7 @@
 
 #include "DBCStores.h"
 #include "BattlegroundMgr.h"
+#include "DBCCache.h"
 #include "DBCFileLoader.h"
 #include "DBCfmt.h"
 #include "DatabaseEnv.h"
@@ -31,6 +32,7 @@
 #include "SpellMgr.h"
 #include "StopWatch.h"
 #include "TransportMgr.h"
+#include <filesystem>
 #include <map>
 #include <sstream>
 
@@ -205,6 +207,7 @@ DBCStorage <WorldMapOverlayEntry> sWorldMapOverlayStore(WorldMapOverlayEntryfmt)
 typedef std::list<std::string> StoreProblemList;
 
 uint32 DBCFileCount = 0;
+uint32 DBCCachedFileCount = 0;
 
 static bool LoadDBC_assert_print(uint32 fsize, uint32 rsize, const std::string& filename)
 {
@@ -215,7 +218,7 @@ static bool LoadDBC_assert_print(uint32 fsize, uint32 rsize, const std::string&
 }
 
 template<class T>
-inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCStorage<T>& storage, std::string const& dbcPath, std::string const& filename, char const* dbTable = nullptr)
+inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCStorage<T>& storage, std::string const& dbcPath, std::string const& cachePath, std::string const& filename, char const* dbTable = nullptr)
 {
     // compatibility format and C++ structure sizes
     ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
@@ -224,21 +227,48 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
     std::string dbcFilename = dbcPath + filename;
     bool existDBData = false;
 
-    if (storage.Load(dbcFilename.c_str()))
+    auto getLocalizedName = [&](uint8 locale)
+    {
+        std::string localizedName(dbcPath);
+        localizedName.append(localeNames[locale]);
+        localizedName.push_back('/');
+        localizedName.append(filename);
+        return localizedName;
+    };
+
+    // the cache is built from the dbc file and the locale files tried with the current locale mask
+    std::string cacheFilename;
+    uint64 sourceHash = DBCCacheFile::HASH_SEED;
+    bool loadedFromCache = false;
+
+    if (!cachePath.empty())
+    {
+        cacheFilename = cachePath + filename + ".cache";
+        sourceHash = DBCCacheFile::HashFile(dbcFilename.c_str(), sourceHash ^ availableDbcLocales);
+
+        for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
+            if (availableDbcLocales & (1 << i))
+                sourceHash = DBCCacheFile::HashFile(getLocalizedName(i).c_str(), sourceHash);
+
+        loadedFromCache = storage.LoadFromCache(cacheFilename.c_str(), sourceHash, availableDbcLocales);
+        if (loadedFromCache)
+            ++DBCCachedFileCount;
+    }
+
+    if (!loadedFromCache && storage.Load(dbcFilename.c_str()))
     {
         for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
         {
             if (!(availableDbcLocales & (1 << i)))
                 continue;
 
-            std::string localizedName(dbcPath);
-            localizedName.append(localeNames[i]);
-            localizedName.push_back('/');
-            localizedName.append(filename);
-
-            if (!storage.LoadStringsFrom(localizedName.c_str()))
+            if (!storage.LoadStringsFrom(getLocalizedName(i).c_str()))
                 availableDbcLocales &= ~(1 << i);             // mark as not available for speedup next checks
         }
+
+        // sql overrides are not part of the cache, they are merged below on every load
+        if (!cacheFilename.empty() && !storage.SaveToCache(cacheFilename.c_str(), sourceHash, availableDbcLocales))
+            LOG_WARN("dbc", "Can't write dbc cache file '{}'", cacheFilename);
     }
 
     if (dbTable)
@@ -268,11 +298,29 @@ void LoadDBCStores(const std::string& dataPath)
     StopWatch sw;
 
     std::string dbcPath = dataPath + "dbc/";
+    std::string cachePath;
+
+    if (CONF_GET_BOOL("DBC.Cache.Enable"))
+    {
+        cachePath = CONF_GET_STR("DBC.Cache.Dir");
+        if (cachePath.empty())
+            cachePath = dbcPath + "cache/";
+        else if (cachePath.back() != '/' && cachePath.back() != '\\')
+            cachePath.push_back('/');
+
+        std::error_code error;
+        std::filesystem::create_directories(cachePath, error);
+        if (error)
+        {
+            LOG_ERROR("dbc", "Can't create dbc cache directory '{}': {}. Loading without cache.", cachePath, error.message());
+            cachePath.clear();
+        }
+    }
 
     StoreProblemList bad_dbc_files;
     uint32 availableDbcLocales = 0xFFFFFFFF;
 
-#define LOAD_DBC(store, file, dbtable) LoadDBC(availableDbcLocales, bad_dbc_files, store, dbcPath, file, dbtable)
+#define LOAD_DBC(store, file, dbtable) LoadDBC(availableDbcLocales, bad_dbc_files, store, dbcPath, cachePath, file, dbtable)
 
     LOAD_DBC(sAreaTableStore,                       "AreaTable.dbc",                        "areatable_dbc");
     LOAD_DBC(sAchievementStore,                     "Achievement.dbc",                      "achievement_dbc");
@@ -651,6 +699,9 @@ void LoadDBCStores(const std::string& dataPath)
         exit(1);
     }
 
+    if (!cachePath.empty())
+        LOG_INFO("server.loading", ">> Loaded {} of {} Data Stores from cache", DBCCachedFileCount, DBCFileCount);
+
     LOG_INFO("server.loading", ">> Initialized {} Data Stores in {}", DBCFileCount, sw);
     LOG_INFO("server.loading", "");
 
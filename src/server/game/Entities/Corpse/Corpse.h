@@ -54,8 +54,11 @@ public:
 
     void AddToWorld() override;
     void RemoveFromWorld() override;
+    void UpdateGridPositionIndex() override { RefreshGridPositionIndex(); }
 
     void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) const override;
+    [[nodiscard]] bool IsValuesUpdateFieldPerTarget(uint16 index) const override;
+    [[nodiscard]] uint32 GetValuesUpdateFieldForTarget(uint16 index, Player* target) const override;
 
     bool Create(ObjectGuid::LowType guidlow);
     bool Create(ObjectGuid::LowType guidlow, Player* owner);
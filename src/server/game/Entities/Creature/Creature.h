@@ -45,6 +45,7 @@ public:
 
     void AddToWorld() override;
     void RemoveFromWorld() override;
+    void UpdateGridPositionIndex() override { RefreshGridPositionIndex(); }
 
     float GetNativeObjectScale() const override;
     void SetObjectScale(float scale) override;
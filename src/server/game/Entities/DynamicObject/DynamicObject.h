@@ -39,6 +39,7 @@ public:
 
     void AddToWorld() override;
     void RemoveFromWorld() override;
+    void UpdateGridPositionIndex() override { RefreshGridPositionIndex(); }
 
     void CleanupsBeforeDelete(bool finalCleanup = true) override;
 
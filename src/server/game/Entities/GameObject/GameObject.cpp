@@ -2804,7 +2804,6 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
         return;
 
     bool forcedFlags = GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo()->chest.groupLootRules && HasLootRecipient();
-    bool targetIsGM = target->IsGameMaster() && AccountMgr::IsGMAccount(target->GetSession()->GetSecurity());
 
     ByteBuffer fieldBuffer;
 
@@ -2823,79 +2822,91 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
                 (index == GAMEOBJECT_FLAGS && forcedFlags))
         {
             updateMask.SetBit(index);
+            fieldBuffer << GetValuesUpdateFieldForTarget(index, target);
+        }
+    }
 
-            if (index == GAMEOBJECT_DYNAMIC)
-            {
-                uint16 dynFlags = 0;
-                int16 pathProgress = -1;
-                switch (GetGoType())
+    *data << uint8(updateMask.GetBlockCount());
+    updateMask.AppendToPacket(data);
+    data->append(fieldBuffer);
+}
+
+bool GameObject::IsValuesUpdateFieldPerTarget(uint16 index) const
+{
+    return index == GAMEOBJECT_DYNAMIC || index == GAMEOBJECT_FLAGS;
+}
+
+uint32 GameObject::GetValuesUpdateFieldForTarget(uint16 index, Player* target) const
+{
+    if (index == GAMEOBJECT_DYNAMIC)
+    {
+        bool targetIsGM = target->IsGameMaster() && AccountMgr::IsGMAccount(target->GetSession()->GetSecurity());
+
+        uint16 dynFlags = 0;
+        int16 pathProgress = -1;
+        switch (GetGoType())
+        {
+            case GAMEOBJECT_TYPE_QUESTGIVER:
+                if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                break;
+            case GAMEOBJECT_TYPE_CHEST:
+            case GAMEOBJECT_TYPE_GOOBER:
+                if (ActivateToQuest(target))
                 {
-                    case GAMEOBJECT_TYPE_QUESTGIVER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_CHEST:
-                    case GAMEOBJECT_TYPE_GOOBER:
-                        if (ActivateToQuest(target))
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                    if (CONF_GET_BOOL("Visibility.ObjectSparkles"))
+                        dynFlags |= GO_DYNFLAG_LO_SPARKLE;
+                }
+                else if (targetIsGM)
+                    dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                break;
+            case GAMEOBJECT_TYPE_SPELL_FOCUS:
+            case GAMEOBJECT_TYPE_GENERIC:
+                if (ActivateToQuest(target) && CONF_GET_BOOL("Visibility.ObjectSparkles"))
+                    dynFlags |= GO_DYNFLAG_LO_SPARKLE;
+                break;
+            case GAMEOBJECT_TYPE_TRANSPORT:
+                if (const StaticTransport* t = ToStaticTransport())
+                    if (t->GetPauseTime())
+                    {
+                        if (GetGoState() == GO_STATE_READY)
                         {
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                            if (CONF_GET_BOOL("Visibility.ObjectSparkles"))
-                                dynFlags |= GO_DYNFLAG_LO_SPARKLE;
+                            if (t->GetPathProgress() >= t->GetPauseTime()) // if not, send 100% progress
+                                pathProgress = int16(float(t->GetPathProgress() - t->GetPauseTime()) / float(t->GetPeriod() - t->GetPauseTime()) * 65535.0f);
                         }
-                        else if (targetIsGM)
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                    case GAMEOBJECT_TYPE_GENERIC:
-                        if (ActivateToQuest(target) && CONF_GET_BOOL("Visibility.ObjectSparkles"))
-                            dynFlags |= GO_DYNFLAG_LO_SPARKLE;
-                        break;
-                    case GAMEOBJECT_TYPE_TRANSPORT:
-                        if (const StaticTransport* t = ToStaticTransport())
-                            if (t->GetPauseTime())
-                            {
-                                if (GetGoState() == GO_STATE_READY)
-                                {
-                                    if (t->GetPathProgress() >= t->GetPauseTime()) // if not, send 100% progress
-                                        pathProgress = int16(float(t->GetPathProgress() - t->GetPauseTime()) / float(t->GetPeriod() - t->GetPauseTime()) * 65535.0f);
-                                }
-                                else
-                                {
-                                    if (t->GetPathProgress() <= t->GetPauseTime()) // if not, send 100% progress
-                                        pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPauseTime()) * 65535.0f);
-                                }
-                            }
-                        // else it's ignored
-                        break;
-                    case GAMEOBJECT_TYPE_MO_TRANSPORT:
-                        if (const MotionTransport* t = ToMotionTransport())
-                            pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPeriod()) * 65535.0f);
-                        break;
-                    default:
-                        break;
-                }
+                        else
+                        {
+                            if (t->GetPathProgress() <= t->GetPauseTime()) // if not, send 100% progress
+                                pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPauseTime()) * 65535.0f);
+                        }
+                    }
+                // else it's ignored
+                break;
+            case GAMEOBJECT_TYPE_MO_TRANSPORT:
+                if (const MotionTransport* t = ToMotionTransport())
+                    pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPeriod()) * 65535.0f);
+                break;
+            default:
+                break;
+        }
 
-                fieldBuffer << uint16(dynFlags);
-                fieldBuffer << int16(pathProgress);
-            }
-            else if (index == GAMEOBJECT_FLAGS)
-            {
-                uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
-                if (GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo() && GetGOInfo()->chest.groupLootRules && !IsLootAllowedFor(target))
-                {
-                    goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
-                }
+        // client reads uint16 flags followed by int16 path progress
+        return uint32(dynFlags) | (uint32(uint16(pathProgress)) << 16);
+    }
 
-                fieldBuffer << goFlags;
-            }
-            else
-                fieldBuffer << m_uint32Values[index];                // other cases
+    if (index == GAMEOBJECT_FLAGS)
+    {
+        uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
+        if (GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo() && GetGOInfo()->chest.groupLootRules && !IsLootAllowedFor(target))
+        {
+            goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
         }
+
+        return goFlags;
     }
 
-    *data << uint8(updateMask.GetBlockCount());
-    updateMask.AppendToPacket(data);
-    data->append(fieldBuffer);
+    return m_uint32Values[index];                           // other cases
 }
 
 void GameObject::GetRespawnPosition(float& x, float& y, float& z, float* ori /* = nullptr*/) const
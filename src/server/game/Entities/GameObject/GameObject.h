@@ -125,9 +125,12 @@ public:
     ~GameObject() override;
 
     void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+    [[nodiscard]] bool IsValuesUpdateFieldPerTarget(uint16 index) const override;
+    [[nodiscard]] uint32 GetValuesUpdateFieldForTarget(uint16 index, Player* target) const override;
 
     void AddToWorld() override;
     void RemoveFromWorld() override;
+    void UpdateGridPositionIndex() override { RefreshGridPositionIndex(); }
     void CleanupsBeforeDelete(bool finalCleanup = true) override;
 
     uint32 GetDynamicFlags() const override { return GetUInt32Value(GAMEOBJECT_DYNAMIC); }
@@ -546,7 +546,23 @@ void Object::ClearUpdateMask(bool remove)
     }
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+ValuesUpdateCache::Block* ValuesUpdateCache::Find(uint32 visibleFlag)
+{
+    for (Block& block : _blocks)
+        if (block.VisibleFlag == visibleFlag)
+            return &block;
+
+    return nullptr;
+}
+
+ValuesUpdateCache::Block& ValuesUpdateCache::Add(uint32 visibleFlag)
+{
+    Block& block = _blocks.emplace_back();
+    block.VisibleFlag = visibleFlag;
+    return block;
+}
+
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateCache* cache /*= nullptr*/) const
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
 
@@ -557,7 +573,49 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    if (!cache || !CanShareValuesUpdate())
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+        return;
+    }
+
+    // which fields are sent only depends on their visibility for the target, build them once per visibility
+    uint32* flags = nullptr;
+    uint32 visibleFlag = GetUpdateFieldData(player, flags);
+
+    if (ValuesUpdateCache::Block* block = cache->Find(visibleFlag))
+    {
+        for (auto const& [index, pos] : block->Targeted)
+            block->Data.put<uint32>(pos, GetValuesUpdateFieldForTarget(index, player));
+
+        iter->second.AddUpdateBlock(block->Data);
+        return;
+    }
+
+    ValuesUpdateCache::Block& block = cache->Add(visibleFlag);
+    block.Data << uint8(UPDATETYPE_VALUES);
+    block.Data << GetPackGUID();
+
+    std::size_t maskOffset = block.Data.wpos();
+    BuildValuesUpdate(UPDATETYPE_VALUES, &block.Data, player);
+
+    // layout: mask block count, mask blocks, one uint32 per set bit in index order
+    uint8 maskBlocks = block.Data.read<uint8>(maskOffset);
+    std::size_t pos = maskOffset + 1 + maskBlocks * sizeof(UpdateMask::ClientUpdateMaskType);
+
+    for (uint16 index = 0; index < m_valuesCount; ++index)
+    {
+        UpdateMask::ClientUpdateMaskType maskPart = block.Data.read<UpdateMask::ClientUpdateMaskType>(maskOffset + 1 + (index / UpdateMask::CLIENT_UPDATE_MASK_BITS) * sizeof(UpdateMask::ClientUpdateMaskType));
+        if (!(maskPart & (1 << (index % UpdateMask::CLIENT_UPDATE_MASK_BITS))))
+            continue;
+
+        if (IsValuesUpdateFieldPerTarget(index))
+            block.Targeted.emplace_back(index, pos);
+
+        pos += sizeof(uint32);
+    }
+
+    iter->second.AddUpdateBlock(block.Data);
 }
 
 uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
@@ -747,6 +805,10 @@ void Object::SetFloatValue(uint16 index, float value)
         m_floatValues[index] = value;
         _changesMask.SetBit(index);
 
+        // both change WorldObject::GetObjectSize()
+        if (index == OBJECT_FIELD_SCALE_X || (index == UNIT_FIELD_COMBATREACH && isType(TYPEMASK_UNIT)))
+            UpdateGridPositionIndex();
+
         AddToObjectUpdateIfNeeded();
     }
 }
@@ -2440,6 +2502,7 @@ Creature* WorldObject::FindNearestCreature(uint32 entry, float range, bool alive
     Creature* creature = nullptr;
     Warhead::NearestCreatureEntryWithLiveStateInObjectRangeCheck checker(*this, entry, alive, range);
     Warhead::CreatureLastSearcher<Warhead::NearestCreatureEntryWithLiveStateInObjectRangeCheck> searcher(this, creature, checker);
+    searcher.i_searchArea.Set(this, range);
     Cell::VisitAllObjects(this, searcher, range);
     return creature;
 }
@@ -2449,6 +2512,7 @@ GameObject* WorldObject::FindNearestGameObject(uint32 entry, float range, bool o
     GameObject* go = nullptr;
     Warhead::NearestGameObjectEntryInObjectRangeCheck checker(*this, entry, range, onlySpawned);
     Warhead::GameObjectLastSearcher<Warhead::NearestGameObjectEntryInObjectRangeCheck> searcher(this, go, checker);
+    searcher.i_searchArea.Set(this, range);
     Cell::VisitGridObjects(this, searcher, range);
     return go;
 }
@@ -2458,6 +2522,7 @@ GameObject* WorldObject::FindNearestGameObjectOfType(GameobjectTypes type, float
     GameObject* go = nullptr;
     Warhead::NearestGameObjectTypeInObjectRangeCheck checker(*this, type, range);
     Warhead::GameObjectLastSearcher<Warhead::NearestGameObjectTypeInObjectRangeCheck> searcher(this, go, checker);
+    searcher.i_searchArea.Set(this, range);
     Cell::VisitGridObjects(this, searcher, range);
     return go;
 }
@@ -2468,6 +2533,7 @@ Player* WorldObject::SelectNearestPlayer(float distance) const
 
     Warhead::NearestPlayerInObjectRangeCheck checker(this, distance);
     Warhead::PlayerLastSearcher<Warhead::NearestPlayerInObjectRangeCheck> searcher(this, target, checker);
+    searcher.i_searchArea.Set(this, distance);
     Cell::VisitWorldObjects(this, searcher, distance);
 
     return target;
@@ -2486,6 +2552,7 @@ void WorldObject::GetGameObjectListWithEntryInGrid(std::list<GameObject*>& gameo
 {
     Warhead::AllGameObjectsWithEntryInRange check(this, entry, maxSearchRange);
     Warhead::GameObjectListSearcher<Warhead::AllGameObjectsWithEntryInRange> searcher(this, gameobjectList, check);
+    searcher.i_searchArea.Set(this, maxSearchRange);
     Cell::VisitGridObjects(this, searcher, maxSearchRange);
 }
 
@@ -2493,6 +2560,7 @@ void WorldObject::GetCreatureListWithEntryInGrid(std::list<Creature*>& creatureL
 {
     Warhead::AllCreaturesOfEntryInRange check(this, entry, maxSearchRange);
     Warhead::CreatureListSearcher<Warhead::AllCreaturesOfEntryInRange> searcher(this, creatureList, check);
+    searcher.i_searchArea.Set(this, maxSearchRange);
     Cell::VisitGridObjects(this, searcher, maxSearchRange);;
 }
 
@@ -2500,6 +2568,7 @@ void WorldObject::GetDeadCreatureListInGrid(std::list<Creature*>& creaturedeadLi
 {
     Warhead::AllDeadCreaturesInRange check(this, maxSearchRange, alive);
     Warhead::CreatureListSearcher<Warhead::AllDeadCreaturesInRange> searcher(this, creaturedeadList, check);
+    searcher.i_searchArea.Set(this, maxSearchRange);
     Cell::VisitGridObjects(this, searcher, maxSearchRange);
 }
 
@@ -2866,6 +2935,7 @@ void WorldObject::SetPhaseMask(uint32 newPhaseMask, bool update)
 {
     sScriptMgr->OnBeforeWorldObjectSetPhaseMask(this, m_phaseMask, newPhaseMask, m_useCombinedPhases, update);
     m_phaseMask = newPhaseMask;
+    UpdateGridPositionIndex();
 
     if (update && IsInWorld())
         UpdateObjectVisibility();
@@ -2940,7 +3010,7 @@ void WorldObject::AddToNotify(uint16 f)
         {
             if (f & NOTIFY_VISIBILITY_CHANGED)
             {
-                uint32 EVENT_VISIBILITY_DELAY = u->FindMap() ? DynamicVisibilityMgr::GetVisibilityNotifyDelay(u->FindMap()->GetEntry()->map_type) : 1000;
+                uint32 EVENT_VISIBILITY_DELAY = u->FindMap() ? u->FindMap()->GetDynamicVisibility().GetVisibilityNotifyDelay() : 1000;
 
                 uint32 diff = getMSTimeDiff(u->m_last_notify_mstime, GameTime::GetGameTimeMS().count());
                 if (diff >= EVENT_VISIBILITY_DELAY / 2)
@@ -2952,7 +3022,7 @@ void WorldObject::AddToNotify(uint16 f)
             }
             else if (f & NOTIFY_AI_RELOCATION)
             {
-                u->m_delayed_unit_ai_notify_timer = u->FindMap() ? DynamicVisibilityMgr::GetAINotifyDelay(u->FindMap()->GetEntry()->map_type) : 500;
+                u->m_delayed_unit_ai_notify_timer = u->FindMap() ? u->FindMap()->GetDynamicVisibility().GetAINotifyDelay() : 500;
             }
 
             m_notifyflags |= f;
@@ -2964,6 +3034,7 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     UpdatePlayerSet& i_playerSet;
     WorldObject& i_object;
+    ValuesUpdateCache i_valuesCache;
     WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d, UpdatePlayerSet& p) : i_updateDatas(d), i_playerSet(p), i_object(obj)
     {
         i_playerSet.clear();
@@ -3024,7 +3095,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (i_playerSet.find(player->GetGUID()) == i_playerSet.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, &i_valuesCache);
             i_playerSet.insert(player->GetGUID());
         }
     }
@@ -92,6 +92,25 @@ struct PositionFullTerrainStatus;
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 typedef GuidUnorderedSet UpdatePlayerSet;
 
+/// Values update blocks of one object, built once per field visibility (public, party, owner, ...)
+/// and shared by all viewers with it. Fields which differ per viewer are patched for every target.
+class WH_GAME_API ValuesUpdateCache
+{
+public:
+    struct Block
+    {
+        uint32 VisibleFlag{};
+        ByteBuffer Data;                                    // whole UPDATETYPE_VALUES block
+        std::vector<std::pair<uint16, std::size_t>> Targeted; // per viewer field index, position of its value in Data
+    };
+
+    Block* Find(uint32 visibleFlag);
+    Block& Add(uint32 visibleFlag);
+
+private:
+    std::vector<Block> _blocks;                             // only a few visibilities per object
+};
+
 class WH_GAME_API Object
 {
 public:
@@ -111,6 +130,9 @@ public:
     [[nodiscard]] float GetObjectScale() const { return GetFloatValue(OBJECT_FIELD_SCALE_X); }
     virtual void SetObjectScale(float scale) { SetFloatValue(OBJECT_FIELD_SCALE_X, scale); }
 
+    // keeps the cell's GridPositionIndex in sync, overridden by the GridObject types
+    virtual void UpdateGridPositionIndex() { }
+
     virtual uint32 GetDynamicFlags() const { return 0; }
     bool HasDynamicFlag(uint32 flag) const { return (GetDynamicFlags() & flag) != 0; }
     virtual void SetDynamicFlag(uint32 flag) { ReplaceAllDynamicFlags(GetDynamicFlags() | flag); }
@@ -182,7 +204,7 @@ public:
     [[nodiscard]] virtual bool hasQuest(uint32 /* quest_id */) const { return false; }
     [[nodiscard]] virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
     virtual void BuildUpdate(UpdateDataMapType&, UpdatePlayerSet&) {}
-    void BuildFieldsUpdate(Player*, UpdateDataMapType&) const;
+    void BuildFieldsUpdate(Player*, UpdateDataMapType&, ValuesUpdateCache* cache = nullptr) const;
 
     void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
     void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= ~flag; }
@@ -224,6 +246,11 @@ protected:
     void BuildMovementUpdate(ByteBuffer* data, uint16 flags) const;
     virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
 
+    // values update fields which are not sent as stored but built for every target, see ValuesUpdateCache
+    [[nodiscard]] virtual bool IsValuesUpdateFieldPerTarget(uint16 /*index*/) const { return false; }
+    [[nodiscard]] virtual uint32 GetValuesUpdateFieldForTarget(uint16 index, Player* /*target*/) const { return m_uint32Values[index]; }
+    [[nodiscard]] virtual bool CanShareValuesUpdate() const { return true; }
+
     uint16 m_objectType;
 
     TypeID m_objectTypeId;
@@ -334,10 +361,41 @@ class GridObject
 {
 public:
     [[nodiscard]] bool IsInGrid() const { return _gridRef.isValid(); }
-    void AddToGrid(GridRefMgr<T>& m) { ASSERT(!IsInGrid()); _gridRef.link(&m, (T*)this); }
-    void RemoveFromGrid() { ASSERT(IsInGrid()); _gridRef.unlink(); }
+
+    void AddToGrid(GridRefMgr<T>& m)
+    {
+        ASSERT(!IsInGrid());
+        _gridRef.link(&m, (T*)this);
+        _gridIndexSlot = m.GetPositionIndex().Insert((T*)this);
+    }
+
+    void RemoveFromGrid()
+    {
+        ASSERT(IsInGrid());
+        _gridRef.getTarget()->GetPositionIndex().Remove(_gridIndexSlot);
+        _gridRef.unlink();
+    }
+
+    // copies position, size and phase into the cell's packed index
+    void RefreshGridPositionIndex()
+    {
+        if (IsInGrid())
+            _gridRef.getTarget()->GetPositionIndex().Update(_gridIndexSlot, (T const*)this);
+    }
+
+    void SetGridIndexSlot(uint32 slot) { _gridIndexSlot = slot; }
+
+protected:
+    ~GridObject()
+    {
+        // objects deleted while still linked (grid unloading) must not stay in the index
+        if (IsInGrid())
+            _gridRef.getTarget()->GetPositionIndex().Remove(_gridIndexSlot);
+    }
+
 private:
     GridReference<T> _gridRef;
+    uint32 _gridIndexSlot{0};
 };
 
 template <class T_VALUES, class T_FLAGS, class FLAG_TYPE, uint8 ARRAY_SIZE>
@@ -402,6 +460,13 @@ public:
     void AddToWorld() override;
     void RemoveFromWorld() override;
 
+    // hide Position::Relocate, grid searchers filter on a packed copy of the position
+    void Relocate(float x, float y) { Position::Relocate(x, y); UpdateGridPositionIndex(); }
+    void Relocate(float x, float y, float z) { Position::Relocate(x, y, z); UpdateGridPositionIndex(); }
+    void Relocate(float x, float y, float z, float orientation) { Position::Relocate(x, y, z, orientation); UpdateGridPositionIndex(); }
+    void Relocate(Position const& pos) { Position::Relocate(pos); UpdateGridPositionIndex(); }
+    void Relocate(Position const* pos) { Position::Relocate(pos); UpdateGridPositionIndex(); }
+
     void GetNearPoint2D(WorldObject const* searcher, float& x, float& y, float distance, float absAngle, Position const* startPos = nullptr) const;
     void GetNearPoint2D(float& x, float& y, float distance, float absAngle, Position const* startPos = nullptr) const;
     void GetNearPoint(WorldObject const* searcher, float& x, float& y, float& z, float searcher_size, float distance2d, float absAngle, float controlZ = 0, Position const* startPos = nullptr) const;
@@ -542,6 +607,7 @@ public:
     void GetCreaturesWithEntryInRange(std::list<Creature*>& creatureList, float radius, uint32 entry);
 
     void SetPositionDataUpdate();
+    [[nodiscard]] bool IsPositionDataUpdatePending() const { return _updatePositionData; }
     void UpdatePositionData();
 
     void AddToObjectUpdate() override;
@@ -27,7 +27,10 @@
 #include "WorldPacket.h"
 #include <zlib.h>
 
-UpdateData::UpdateData() : m_blockCount(0)
+std::atomic<uint64> UpdateData::_rawBytes{};
+std::atomic<uint64> UpdateData::_compressedBytes{};
+
+UpdateData::UpdateData() : m_blockCount(0), m_hasCreateBlocks(false)
 {
     m_outOfRangeGUIDs.reserve(15);
 }
@@ -39,6 +42,9 @@ void UpdateData::AddOutOfRangeGUID(ObjectGuid guid)
 
 void UpdateData::AddUpdateBlock(const ByteBuffer& block)
 {
+    if (!block.empty() && (block[0] == UPDATETYPE_CREATE_OBJECT || block[0] == UPDATETYPE_CREATE_OBJECT2))
+        m_hasCreateBlocks = true;
+
     m_data.append(block);
     ++m_blockCount;
 }
@@ -47,9 +53,10 @@ void UpdateData::AddUpdateBlock(const UpdateData& block)
 {
     m_data.append(block.m_data);
     m_blockCount += block.m_blockCount;
+    m_hasCreateBlocks = m_hasCreateBlocks || block.m_hasCreateBlocks;
 }
 
-void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
+bool UpdateData::Compress(void* dst, uint32* dst_size, void const* src, int src_size, int level)
 {
     z_stream c_stream;
 
@@ -58,17 +65,17 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
     c_stream.opaque = (voidpf)0;
 
     // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, CONF_GET_INT("Compression"));
+    int z_res = deflateInit(&c_stream, level);
     if (z_res != Z_OK)
     {
         LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateInit) Error code: {} ({})", z_res, zError(z_res));
         *dst_size = 0;
-        return;
+        return false;
     }
 
     c_stream.next_out = (Bytef*)dst;
     c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
+    c_stream.next_in = (Bytef*)const_cast<void*>(src);
     c_stream.avail_in = (uInt)src_size;
 
     z_res = deflate(&c_stream, Z_NO_FLUSH);
@@ -76,14 +83,14 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
     {
         LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate) Error code: {} ({})", z_res, zError(z_res));
         *dst_size = 0;
-        return;
+        return false;
     }
 
     if (c_stream.avail_in != 0)
     {
         LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate not greedy)");
         *dst_size = 0;
-        return;
+        return false;
     }
 
     z_res = deflate(&c_stream, Z_FINISH);
@@ -91,7 +98,7 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
     {
         LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate should report Z_STREAM_END instead {} ({})", z_res, zError(z_res));
         *dst_size = 0;
-        return;
+        return false;
     }
 
     z_res = deflateEnd(&c_stream);
@@ -99,10 +106,11 @@ void UpdateData::Compress(void* dst, uint32* dst_size, void* src, int src_size)
     {
         LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateEnd) Error code: {} ({})", z_res, zError(z_res));
         *dst_size = 0;
-        return;
+        return false;
     }
 
     *dst_size = c_stream.total_out;
+    return true;
 }
 
 bool UpdateData::BuildPacket(WorldPacket* packet)
@@ -128,25 +136,47 @@ bool UpdateData::BuildPacket(WorldPacket* packet)
 
     size_t pSize = buf.wpos();                              // use real used data size
 
-    if (pSize > 100)                                       // compress large packets
+    packet->SetDeferredCompressionLevel(0);
+
+    if (pSize > CONF_GET_UINT("Compression.UpdateObject.MinSize")) // compress large packets
     {
-        uint32 destsize = compressBound(pSize);
-        packet->resize(destsize + sizeof(uint32));
+        // object creation bursts (login, teleport) may use a different level than ongoing updates
+        int level = m_hasCreateBlocks ? CONF_GET_INT("Compression.UpdateObject.CreateLevel") : CONF_GET_INT("Compression");
 
-        packet->put<uint32>(0, pSize);
-        Compress(const_cast<uint8*>(packet->contents()) + sizeof(uint32), &destsize, (void*)buf.contents(), pSize);
-        if (destsize == 0)
-            return false;
+        // keep deflate off the map threads, WorldSocket compresses it before sending
+        if (CONF_GET_BOOL("Compression.UpdateObject.Offload"))
+        {
+            packet->append(buf);
+            packet->SetOpcode(SMSG_UPDATE_OBJECT);
+            packet->SetDeferredCompressionLevel(uint8(level));
+            return true;
+        }
 
-        packet->resize(destsize + sizeof(uint32));
-        packet->SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
-    }
-    else                                                    // send small packets without compression
-    {
-        packet->append(buf);
-        packet->SetOpcode(SMSG_UPDATE_OBJECT);
+        return CompressPacket(packet, buf, level);
     }
 
+    // send small packets without compression
+    packet->append(buf);
+    packet->SetOpcode(SMSG_UPDATE_OBJECT);
+    return true;
+}
+
+bool UpdateData::CompressPacket(WorldPacket* packet, ByteBuffer const& data, int level)
+{
+    size_t pSize = data.wpos();
+    uint32 destsize = compressBound(pSize);
+    packet->resize(destsize + sizeof(uint32));
+
+    packet->put<uint32>(0, pSize);
+    if (!Compress(packet->contents() + sizeof(uint32), &destsize, data.contents(), pSize, level))
+        return false;
+
+    packet->resize(destsize + sizeof(uint32));
+    packet->SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
+    packet->SetDeferredCompressionLevel(0);
+
+    _rawBytes += pSize;
+    _compressedBytes += destsize + sizeof(uint32);
     return true;
 }
 
@@ -155,4 +185,5 @@ void UpdateData::Clear()
     m_data.clear();
     m_outOfRangeGUIDs.clear();
     m_blockCount = 0;
+    m_hasCreateBlocks = false;
 }
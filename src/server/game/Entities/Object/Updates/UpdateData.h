@@ -20,6 +20,7 @@
 
 #include "ByteBuffer.h"
 #include "ObjectGuid.h"
+#include <atomic>
 
 class WorldPacket;
 
@@ -60,11 +61,22 @@ public:
     [[nodiscard]] bool HasData() const { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
     void Clear();
 
+    /// writes data as SMSG_COMPRESSED_UPDATE_OBJECT into packet
+    static bool CompressPacket(WorldPacket* packet, ByteBuffer const& data, int level);
+
+    /// update object bytes before and after compression, in map and network threads
+    static uint64 GetRawBytes() { return _rawBytes; }
+    static uint64 GetCompressedBytes() { return _compressedBytes; }
+
 protected:
     uint32 m_blockCount;
     GuidVector m_outOfRangeGUIDs;
     ByteBuffer m_data;
+    bool m_hasCreateBlocks;
+
+    static bool Compress(void* dst, uint32* dst_size, void const* src, int src_size, int level);
 
-    void Compress(void* dst, uint32* dst_size, void* src, int src_size);
+    static std::atomic<uint64> _rawBytes;
+    static std::atomic<uint64> _compressedBytes;
 };
 #endif
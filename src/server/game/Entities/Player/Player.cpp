@@ -181,6 +181,7 @@ Player::Player(WorldSession* session): Unit(true), m_mover(this)
     m_zoneUpdateTimer = 0;
 
     m_nextSave = CONF_GET_INT("PlayerSaveInterval");
+    m_saveDeferredTime = 0;
 
     m_areaUpdateId = 0;
     m_team = TEAM_NEUTRAL;
@@ -3573,16 +3574,13 @@ void Player::_LoadSpellCooldowns(PreparedQueryResult result)
 
 void Player::_SaveSpellCooldowns(CharacterDatabaseTransaction trans, bool logout)
 {
-    CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN);
-    stmt->SetData(0, GetGUID().GetCounter());
-    trans->Append(stmt);
-
     time_t curTime = GameTime::GetGameTime().count();
     uint32 curMSTime = GameTime::GetGameTimeMS().count();
     uint32 infTime = curMSTime + infinityCooldownDelayCheck;
 
     bool first_round = true;
     std::ostringstream ss;
+    PlayerSaveHash hash;
 
     // remove outdated and save active
     for (SpellCooldowns::iterator itr = m_spellCooldowns.begin(); itr != m_spellCooldowns.end();)
@@ -3609,11 +3607,22 @@ void Player::_SaveSpellCooldowns(CharacterDatabaseTransaction trans, bool logout
 
             uint64 cooldown = uint64(((itr->second.end - curMSTime) / IN_MILLISECONDS) + curTime);
             ss << '(' << GetGUID().GetCounter() << ',' << itr->first << ',' << itr->second.category << "," << itr->second.itemid << ',' << cooldown << ',' << (itr->second.needSendToClient ? '1' : '0') << ')';
+
+            // end instead of the stored time, it moves by a second between saves
+            hash << itr->first << itr->second.category << itr->second.itemid << itr->second.end << itr->second.needSendToClient;
             ++itr;
         }
         else
             ++itr;
     }
+
+    if (!IsSaveBlockChanged(PLAYER_SAVE_BLOCK_SPELL_COOLDOWNS, hash.GetHash(), first_round ? 1 : 2))
+        return;
+
+    CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN);
+    stmt->SetData(0, GetGUID().GetCounter());
+    trans->Append(stmt);
+
     // if something changed execute
     if (!first_round)
         trans->Append(ss.str().c_str());
@@ -14539,6 +14548,14 @@ void Player::_SaveEntryPoint(CharacterDatabaseTransaction trans)
     if (!mEntry)
         return;
 
+    PlayerSaveHash hash;
+    hash << m_entryPointData.joinPos.GetPositionX() << m_entryPointData.joinPos.GetPositionY() << m_entryPointData.joinPos.GetPositionZ()
+        << m_entryPointData.joinPos.GetOrientation() << m_entryPointData.joinPos.GetMapId()
+        << m_entryPointData.taxiPath[0] << m_entryPointData.taxiPath[1] << m_entryPointData.mountSpell;
+
+    if (!IsSaveBlockChanged(PLAYER_SAVE_BLOCK_ENTRY_POINT, hash.GetHash(), 2))
+        return;
+
     CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYER_ENTRY_POINT);
     stmt->SetData(0, GetGUID().GetCounter());
     trans->Append(stmt);
@@ -15810,6 +15827,13 @@ void Player::_SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans)
     if (_instanceResetTimes.empty())
         return;
 
+    PlayerSaveHash hash;
+    for (auto const& [instanceId, resetTime] : _instanceResetTimes)
+        hash << instanceId << resetTime;
+
+    if (!IsSaveBlockChanged(PLAYER_SAVE_BLOCK_INSTANCE_TIMES, hash.GetHash(), uint32(_instanceResetTimes.size()) + 1))
+        return;
+
     CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIMES);
     stmt->SetData(0, GetSession()->GetAccountId());
     trans->Append(stmt);
@@ -32,6 +32,7 @@
 #include "ObjectMgr.h"
 #include "Optional.h"
 #include "PetDefines.h"
+#include "PlayerSaveBlocks.h"
 #include "PlayerTaxi.h"
 #include "QuestDef.h"
 #include "SpellAuras.h"
@@ -1062,6 +1063,7 @@ public:
 
     void AddToWorld() override;
     void RemoveFromWorld() override;
+    void UpdateGridPositionIndex() override { RefreshGridPositionIndex(); }
 
     void SetObjectScale(float scale) override
     {
@@ -2338,6 +2340,8 @@ public:
     // currently visible objects at player client
     GuidUnorderedSet m_clientGUIDs;
     std::vector<Unit*> m_newVisible; // pussywizard
+    uint32 m_fullVisibilityUpdateCell{0xFFFFFFFF}; // cell id and game time of the last full visibility rescan
+    uint32 m_fullVisibilityUpdateTime{0};
 
     [[nodiscard]] bool HaveAtClient(WorldObject const* u) const;
     [[nodiscard]] bool HaveAtClient(ObjectGuid guid) const;
@@ -2349,6 +2353,9 @@ public:
     void GetInitialVisiblePackets(Unit* target);
     void UpdateObjectVisibility(bool forced = true, bool fromUpdate = false) override;
     void UpdateVisibilityForPlayer(bool mapChange = false);
+    [[nodiscard]] bool CanUpdateVisibilityIncrementally(float moveDist) const;
+    void UpdateVisibilityIncrementally(float moveDist);
+    void SetFullVisibilityUpdateDone();
     void UpdateVisibilityOf(WorldObject* target);
     void UpdateTriggerVisibility();
 
@@ -2694,6 +2701,11 @@ public:
     void _SaveCharacter(bool create, CharacterDatabaseTransaction trans);
     void _SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans);
 
+    // False if the block would write the same data as the last committed save
+    bool IsSaveBlockChanged(PlayerSaveBlock block, uint64 hash, uint32 statements) { return m_saveBlocks.IsChanged(block, hash, statements); }
+    // Commit callback of the last SaveToDB(trans, ...), confirms the blocks it wrote when the transaction succeeded
+    [[nodiscard]] std::function<void(bool)> GetSaveBlocksConfirmation() const;
+
     /*********************************************************/
     /***              ENVIRONMENTAL SYSTEM                 ***/
     /*********************************************************/
@@ -2713,8 +2725,10 @@ public:
 
     TeamId m_team;
     uint32 m_nextSave; // pussywizard
+    uint32 m_saveDeferredTime;
     uint16 m_additionalSaveTimer; // pussywizard
     uint8 m_additionalSaveMask; // pussywizard
+    PlayerSaveBlocks m_saveBlocks;
     uint16 m_hostileReferenceCheckTimer; // pussywizard
     std::array<ChatFloodThrottle, ChatFloodThrottle::MAX> m_chatFloodData;
     Difficulty m_dungeonDifficulty;
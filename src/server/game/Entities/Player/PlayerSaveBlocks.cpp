@@ -0,0 +1,66 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include "PlayerSaveBlocks.h"
+#include <atomic>
+
+namespace
+{
+    // unique over all players, a late confirmation can't match the saves of a new login of the character
+    std::atomic<uint32> NextSaveSequence{ 1 };
+}
+
+void PlayerSaveBlocks::BeginSave(bool logout)
+{
+    _sequence = NextSaveSequence++;
+    _pendingHashes.fill(0);
+    _skippedStatements = 0;
+
+    // the next login starts without hashes anyway
+    if (logout)
+        _hashes.fill(0);
+}
+
+bool PlayerSaveBlocks::IsChanged(PlayerSaveBlock block, uint64 hash, uint32 statements)
+{
+    if (_hashes[block] == hash)
+    {
+        _skippedStatements += statements;
+        return false;
+    }
+
+    // unknown until this save is committed
+    _hashes[block] = 0;
+    _pendingHashes[block] = hash;
+    _sequences[block] = _sequence;
+    return true;
+}
+
+PlayerSaveBlocks::Confirmation PlayerSaveBlocks::GetConfirmation() const
+{
+    return { _sequence, _pendingHashes };
+}
+
+void PlayerSaveBlocks::Confirm(Confirmation const& confirmation)
+{
+    for (uint8 block = 0; block < MAX_PLAYER_SAVE_BLOCKS; ++block)
+        if (confirmation.Hashes[block] && _sequences[block] == confirmation.Sequence)
+            _hashes[block] = confirmation.Hashes[block];
+}
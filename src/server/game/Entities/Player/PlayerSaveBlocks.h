@@ -0,0 +1,96 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PLAYER_SAVE_BLOCKS_H__
+#define __PLAYER_SAVE_BLOCKS_H__
+
+#include "Define.h"
+#include <array>
+#include <type_traits>
+
+// Save blocks rewritten as a whole (delete + insert) on every save, skipped while their data is unchanged
+enum PlayerSaveBlock
+{
+    PLAYER_SAVE_BLOCK_AURAS,
+    PLAYER_SAVE_BLOCK_SPELL_COOLDOWNS,
+    PLAYER_SAVE_BLOCK_ENTRY_POINT,
+    PLAYER_SAVE_BLOCK_STATS,
+    PLAYER_SAVE_BLOCK_INSTANCE_TIMES,
+
+    MAX_PLAYER_SAVE_BLOCKS
+};
+
+// FNV-1a over the values a save block writes
+class PlayerSaveHash
+{
+public:
+    template<typename T>
+    PlayerSaveHash& operator<<(T value)
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+
+        uint8 const* bytes = reinterpret_cast<uint8 const*>(&value);
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+            _hash = (_hash ^ bytes[i]) * 1099511628211ULL;
+
+        return *this;
+    }
+
+    [[nodiscard]] uint64 GetHash() const { return _hash; }
+
+private:
+    uint64 _hash{ 14695981039346656037ULL };
+};
+
+/*
+  Tracks which save blocks hold the same data as the database.
+  A block is only skipped once the save that wrote its data was committed: every save takes a
+  confirmation with the blocks it wrote, which is handed back to Confirm from the commit callback.
+  A written block is written again by every save until then.
+*/
+class WH_GAME_API PlayerSaveBlocks
+{
+public:
+    struct Confirmation
+    {
+        uint32 Sequence{ 0 };
+        std::array<uint64, MAX_PLAYER_SAVE_BLOCKS> Hashes{ };
+    };
+
+    // Starts a new save, nothing is skipped by a logout save
+    void BeginSave(bool logout);
+
+    // False if the block would write the same data as the last committed save, the skipped statements are counted
+    bool IsChanged(PlayerSaveBlock block, uint64 hash, uint32 statements);
+
+    // Blocks written by the current save
+    [[nodiscard]] Confirmation GetConfirmation() const;
+
+    // The save of the confirmation was committed, blocks written again by a later save wait for that one
+    void Confirm(Confirmation const& confirmation);
+
+    [[nodiscard]] uint32 GetSkippedStatements() const { return _skippedStatements; }
+
+private:
+    std::array<uint64, MAX_PLAYER_SAVE_BLOCKS> _hashes{ };          // data in the database, 0 when unknown
+    std::array<uint64, MAX_PLAYER_SAVE_BLOCKS> _pendingHashes{ };   // blocks written by the current save
+    std::array<uint32, MAX_PLAYER_SAVE_BLOCKS> _sequences{ };       // save that last wrote the block
+    uint32 _sequence{ 0 };
+    uint32 _skippedStatements{ 0 };
+};
+
+#endif
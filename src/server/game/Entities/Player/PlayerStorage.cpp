@@ -51,6 +51,7 @@
 #include "Log.h"
 #include "LootItemStorage.h"
 #include "MapMgr.h"
+#include "Metric.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "OutdoorPvP.h"
@@ -7079,11 +7080,27 @@ void Player::SaveToDB(bool create, bool logout)
 
     SaveToDB(trans, create, logout);
 
-    CharacterDatabase.CommitTransaction(trans);
+    GetSession()->AddTransactionCallback(CharacterDatabase.AsyncCommitTransaction(trans)).AfterComplete(GetSaveBlocksConfirmation());
+}
+
+std::function<void(bool)> Player::GetSaveBlocksConfirmation() const
+{
+    // skipping unchanged blocks is only safe once their data is known to be committed
+    return [guid = GetGUID(), confirmation = m_saveBlocks.GetConfirmation()](bool success)
+    {
+        if (!success)
+            return;
+
+        if (Player* player = ObjectAccessor::FindConnectedPlayer(guid))
+            player->m_saveBlocks.Confirm(confirmation);
+    };
 }
 
 void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logout)
 {
+    // the caller commits trans with GetSaveBlocksConfirmation as callback, unconfirmed blocks keep being written
+    m_saveBlocks.BeginSave(logout);
+
     // delay auto save at any saves (manual, in code, or autosave)
     m_nextSave = CONF_GET_INT("PlayerSaveInterval");
 
@@ -7107,6 +7124,8 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     if (!create)
         sScriptMgr->OnPlayerSave(this);
 
+    std::size_t statementsBefore = trans->GetSize();
+
     _SaveCharacter(create, trans);
 
     if (m_mailsUpdated)                                     //save mails only when needed
@@ -7137,6 +7156,12 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     if (m_session->isLogingOut() || !CONF_GET_BOOL("PlayerSave.Stats.SaveOnlyOnLogout"))
         _SaveStats(trans);
 
+    std::size_t statements = trans->GetSize() - statementsBefore;
+
+    LOG_DEBUG("entities.player", "Player {} saved with {} statements, {} skipped for unchanged data", GetName(), statements, m_saveBlocks.GetSkippedStatements());
+    METRIC_VALUE("player_save_statements", uint64(statements));
+    METRIC_VALUE("player_save_statements_skipped", uint64(m_saveBlocks.GetSkippedStatements()));
+
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
         pet->SavePetToDB(PET_SAVE_AS_CURRENT);
@@ -7207,9 +7232,8 @@ void Player::_SaveActions(CharacterDatabaseTransaction trans)
 
 void Player::_SaveAuras(CharacterDatabaseTransaction trans, bool logout)
 {
-    CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
-    stmt->SetData(0, GetGUID().GetCounter());
-    trans->Append(stmt);
+    std::vector<CharacterDatabasePreparedStatement> statements;
+    PlayerSaveHash hash;
 
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
@@ -7242,25 +7266,37 @@ void Player::_SaveAuras(CharacterDatabaseTransaction trans, bool logout)
         }
 
         uint8 index = 0;
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_AURA);
-        stmt->SetData(index++, GetGUID().GetCounter());
-        stmt->SetData(index++, itr->second->GetCasterGUID().GetRawValue());
-        stmt->SetData(index++, itr->second->GetCastItemGUID().GetRawValue());
-        stmt->SetData(index++, itr->second->GetId());
-        stmt->SetData(index++, effMask);
-        stmt->SetData(index++, recalculateMask);
-        stmt->SetData(index++, itr->second->GetStackAmount());
-        stmt->SetData(index++, damage[0]);
-        stmt->SetData(index++, damage[1]);
-        stmt->SetData(index++, damage[2]);
-        stmt->SetData(index++, baseDamage[0]);
-        stmt->SetData(index++, baseDamage[1]);
-        stmt->SetData(index++, baseDamage[2]);
-        stmt->SetData(index++, itr->second->GetMaxDuration());
-        stmt->SetData(index++, itr->second->GetDuration());
-        stmt->SetData(index, itr->second->GetCharges());
-        trans->Append(stmt);
-    }
+        CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_AURA);
+        auto setData = [&](auto value) { stmt->SetData(index++, value); hash << value; };
+
+        setData(GetGUID().GetCounter());
+        setData(itr->second->GetCasterGUID().GetRawValue());
+        setData(itr->second->GetCastItemGUID().GetRawValue());
+        setData(itr->second->GetId());
+        setData(effMask);
+        setData(recalculateMask);
+        setData(itr->second->GetStackAmount());
+        setData(damage[0]);
+        setData(damage[1]);
+        setData(damage[2]);
+        setData(baseDamage[0]);
+        setData(baseDamage[1]);
+        setData(baseDamage[2]);
+        setData(itr->second->GetMaxDuration());
+        setData(itr->second->GetDuration());
+        setData(itr->second->GetCharges());
+        statements.push_back(std::move(stmt));
+    }
+
+    if (!IsSaveBlockChanged(PLAYER_SAVE_BLOCK_AURAS, hash.GetHash(), uint32(statements.size()) + 1))
+        return;
+
+    CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
+    stmt->SetData(0, GetGUID().GetCounter());
+    trans->Append(stmt);
+
+    for (CharacterDatabasePreparedStatement& insert : statements)
+        trans->Append(std::move(insert));
 }
 
 void Player::_SaveInventory(CharacterDatabaseTransaction trans)
@@ -7770,37 +7806,41 @@ void Player::_SaveStats(CharacterDatabaseTransaction trans)
     if (!CONF_GET_INT("PlayerSave.Stats.MinLevel") || GetLevel() < CONF_GET_INT("PlayerSave.Stats.MinLevel"))
         return;
 
-    CharacterDatabasePreparedStatement stmt = nullptr;
-
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_STATS);
-    stmt->SetData(0, GetGUID().GetCounter());
-    trans->Append(stmt);
-
     uint8 index = 0;
+    PlayerSaveHash hash;
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_STATS);
-    stmt->SetData(index++, GetGUID().GetCounter());
-    stmt->SetData(index++, GetMaxHealth());
+    CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_STATS);
+    auto setData = [&](auto value) { stmt->SetData(index++, value); hash << value; };
+
+    setData(GetGUID().GetCounter());
+    setData(GetMaxHealth());
 
     for (uint8 i = 0; i < MAX_POWERS; ++i)
-        stmt->SetData(index++, GetMaxPower(Powers(i)));
+        setData(GetMaxPower(Powers(i)));
 
     for (uint8 i = 0; i < MAX_STATS; ++i)
-        stmt->SetData(index++, GetStat(Stats(i)));
+        setData(GetStat(Stats(i)));
 
     for (int i = 0; i < MAX_SPELL_SCHOOL; ++i)
-        stmt->SetData(index++, GetResistance(SpellSchools(i)));
-
-    stmt->SetData(index++, GetFloatValue(PLAYER_BLOCK_PERCENTAGE));
-    stmt->SetData(index++, GetFloatValue(PLAYER_DODGE_PERCENTAGE));
-    stmt->SetData(index++, GetFloatValue(PLAYER_PARRY_PERCENTAGE));
-    stmt->SetData(index++, GetFloatValue(PLAYER_CRIT_PERCENTAGE));
-    stmt->SetData(index++, GetFloatValue(PLAYER_RANGED_CRIT_PERCENTAGE));
-    stmt->SetData(index++, GetFloatValue(PLAYER_SPELL_CRIT_PERCENTAGE1));
-    stmt->SetData(index++, GetUInt32Value(UNIT_FIELD_ATTACK_POWER));
-    stmt->SetData(index++, GetUInt32Value(UNIT_FIELD_RANGED_ATTACK_POWER));
-    stmt->SetData(index++, GetBaseSpellPowerBonus());
-    stmt->SetData(index++, GetUInt32Value(PLAYER_FIELD_COMBAT_RATING_1 + static_cast<uint16>(CR_CRIT_TAKEN_SPELL)));
+        setData(GetResistance(SpellSchools(i)));
+
+    setData(GetFloatValue(PLAYER_BLOCK_PERCENTAGE));
+    setData(GetFloatValue(PLAYER_DODGE_PERCENTAGE));
+    setData(GetFloatValue(PLAYER_PARRY_PERCENTAGE));
+    setData(GetFloatValue(PLAYER_CRIT_PERCENTAGE));
+    setData(GetFloatValue(PLAYER_RANGED_CRIT_PERCENTAGE));
+    setData(GetFloatValue(PLAYER_SPELL_CRIT_PERCENTAGE1));
+    setData(GetUInt32Value(UNIT_FIELD_ATTACK_POWER));
+    setData(GetUInt32Value(UNIT_FIELD_RANGED_ATTACK_POWER));
+    setData(GetBaseSpellPowerBonus());
+    setData(GetUInt32Value(PLAYER_FIELD_COMBAT_RATING_1 + static_cast<uint16>(CR_CRIT_TAKEN_SPELL)));
+
+    if (!IsSaveBlockChanged(PLAYER_SAVE_BLOCK_STATS, hash.GetHash(), 2))
+        return;
+
+    CharacterDatabasePreparedStatement deleteStmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_STATS);
+    deleteStmt->SetData(0, GetGUID().GetCounter());
+    trans->Append(deleteStmt);
 
     trans->Append(stmt);
 }
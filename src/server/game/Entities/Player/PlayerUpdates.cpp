@@ -37,6 +37,7 @@
 #include "OutdoorPvPMgr.h"
 #include "Pet.h"
 #include "Player.h"
+#include "PlayerSaveScheduler.h"
 #include "ScriptMgr.h"
 #include "SkillDiscovery.h"
 #include "SpellAuraEffects.h"
@@ -308,9 +309,22 @@ void Player::Update(uint32 p_time)
     {
         if (p_time >= m_nextSave)
         {
-            // m_nextSave reset in SaveToDB call
-            SaveToDB(false, false);
-            LOG_DEBUG("entities.player", "Player::Update: Player '{}' ({}) saved", GetName(), GetGUID().ToString());
+            if (sPlayerSaveScheduler->TryStartSave(m_saveDeferredTime))
+            {
+                m_saveDeferredTime = 0;
+
+                // m_nextSave reset in SaveToDB call
+                CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+                SaveToDB(trans, false, false);
+                sPlayerSaveScheduler->CommitSave(trans, GetSaveBlocksConfirmation());
+                LOG_DEBUG("entities.player", "Player::Update: Player '{}' ({}) saved", GetName(), GetGUID().ToString());
+            }
+            else
+            {
+                // retried on the next update
+                m_saveDeferredTime += p_time;
+                m_nextSave = 1;
+            }
         }
         else
         {
@@ -1443,6 +1457,41 @@ void Player::UpdateVisibilityForPlayer(bool mapChange)
 
     if (mapChange)
         m_last_notify_position.Relocate(-5000.0f, -5000.0f, -5000.0f, 0.0f);
+
+    SetFullVisibilityUpdateDone();
+}
+
+bool Player::CanUpdateVisibilityIncrementally(float moveDist) const
+{
+    DynamicVisibilityController const& dynamicVisibility = GetMap()->GetDynamicVisibility();
+    if (!dynamicVisibility.IsIncrementalUpdateEnabled())
+        return false;
+
+    // objects visible before the move must still be inside the visited cells
+    if (moveDist >= VISIBILITY_INC_FOR_GOBJECTS)
+        return false;
+
+    // ghosts see around their corpse, viewpoints and passengers are not measured from the player's position
+    if (!IsAlive() || m_seer != this || GetViewpoint() || GetFarSightDistance() || GetTransport() || GetVehicle())
+        return false;
+
+    if (Warhead::ComputeCellCoord(GetPositionX(), GetPositionY()).GetId() != m_fullVisibilityUpdateCell)
+        return false;
+
+    return getMSTimeDiff(m_fullVisibilityUpdateTime, GameTime::GetGameTimeMS().count()) < dynamicVisibility.GetFullUpdateInterval();
+}
+
+void Player::UpdateVisibilityIncrementally(float moveDist)
+{
+    Warhead::IncrementalVisibleNotifier notifier(*this, moveDist);
+    Cell::VisitAllObjects(this, notifier, GetSightRange() + VISIBILITY_INC_FOR_GOBJECTS);
+    notifier.SendToSelf();
+}
+
+void Player::SetFullVisibilityUpdateDone()
+{
+    m_fullVisibilityUpdateCell = Warhead::ComputeCellCoord(GetPositionX(), GetPositionY()).GetId();
+    m_fullVisibilityUpdateTime = GameTime::GetGameTimeMS().count();
 }
 
 void Player::UpdateObjectVisibility(bool forced, bool fromUpdate)
@@ -432,7 +432,7 @@ void Unit::Update(uint32 p_time)
             {
                 m_delayed_unit_relocation_timer = 0;
                 //ExecuteDelayedUnitRelocationEvent();
-                FindMap()->i_objectsForDelayedVisibility.insert(this);
+                FindMap()->AddObjectToDelayedVisibility(this);
             }
             else
                 m_delayed_unit_relocation_timer -= p_time;
@@ -4637,10 +4637,37 @@ void Unit::_RemoveNoStackAurasDueToAura(Aura* aura)
 
 void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
 {
+    uint16 type = uint16(aurEff->GetAuraType());
+    auto itr = std::lower_bound(m_modAuraArrays.begin(), m_modAuraArrays.end(), type,
+        [](std::pair<uint16, std::vector<AuraEffect*>> const& array, uint16 arrayType) { return array.first < arrayType; });
+
     if (apply)
-        m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
+    {
+        m_modAuras[type].push_back(aurEff);
+
+        // arrays are kept once created, so reapplying a type only appends
+        if (itr == m_modAuraArrays.end() || itr->first != type)
+            itr = m_modAuraArrays.emplace(itr, type, std::vector<AuraEffect*>());
+
+        itr->second.push_back(aurEff);
+    }
     else
-        m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+    {
+        m_modAuras[type].remove(aurEff);
+
+        if (itr != m_modAuraArrays.end() && itr->first == type)
+            std::erase(itr->second, aurEff);
+    }
+}
+
+std::span<AuraEffect* const> Unit::GetAuraEffectSpanByType(AuraType type) const
+{
+    if (m_modAuras[type].empty())
+        return {};
+
+    auto itr = std::lower_bound(m_modAuraArrays.begin(), m_modAuraArrays.end(), uint16(type),
+        [](std::pair<uint16, std::vector<AuraEffect*>> const& array, uint16 arrayType) { return array.first < arrayType; });
+    return itr->second;
 }
 
 // All aura base removes should go threw this function!
@@ -5820,185 +5847,251 @@ int32 Unit::GetTotalAuraModifierAreaExclusive(AuraType auratype) const
     int32 modifier = 0;
     int32 areaModifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    std::span<AuraEffect* const> mTotalAuraList = GetAuraEffectSpanByType(auratype);
+    for (AuraEffect const* aurEff : mTotalAuraList)
     {
-        if ((*i)->GetSpellInfo()->HasAreaAuraEffect())
+        if (aurEff->GetSpellInfo()->HasAreaAuraEffect())
         {
-            if (areaModifier < (*i)->GetAmount())
-                areaModifier = (*i)->GetAmount();
+            if (areaModifier < aurEff->GetAmount())
+                areaModifier = aurEff->GetAmount();
         }
         else
-            modifier += (*i)->GetAmount();
+            modifier += aurEff->GetAmount();
     }
 
     return modifier + areaModifier;
 }
 
-int32 Unit::GetTotalAuraModifier(AuraType auratype) const
+template<class T, class Calculator>
+T Unit::GetCachedAuraModifier(std::unordered_map<uint64, T>& cache, AuraType auraType, AuraModifierQuery query, uint32 misc, Calculator calculate) const
 {
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    if (mTotalAuraList.empty())
-        return 0;
+    // nothing to sum, cheaper than a lookup
+    if (m_modAuras[auraType].empty())
+        return calculate(std::span<AuraEffect* const>());
 
-    int32 modifier = 0;
+    uint64 key = (uint64(auraType) << 40) | (uint64(query) << 32) | misc;
 
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        modifier += (*i)->GetAmount();
+    auto itr = cache.find(key);
+    if (itr != cache.end())
+    {
+#ifdef WARHEAD_DEBUG
+        T calculated = calculate(GetAuraEffectSpanByType(auraType));
+        ASSERT(itr->second == calculated, "Stale aura modifier cache for aura type {} query {} misc {}: cached {}, calculated {}",
+            uint32(auraType), uint32(query), misc, itr->second, calculated);
+#endif
+        return itr->second;
+    }
 
-    return modifier;
+    T value = calculate(GetAuraEffectSpanByType(auraType));
+    cache.emplace(key, value);
+    m_auraModifierCachedTypes.set(auraType);
+    return value;
+}
+
+void Unit::InvalidateAuraModifierCache(AuraType auraType)
+{
+    if (!m_auraModifierCachedTypes.test(auraType))
+        return;
+
+    m_auraModifierCachedTypes.reset(auraType);
+
+    auto isOfType = [auraType](auto const& entry) { return (entry.first >> 40) == uint64(auraType); };
+    std::erase_if(m_auraModifierCache, isOfType);
+    std::erase_if(m_auraMultiplierCache, isOfType);
+}
+
+int32 Unit::GetTotalAuraModifier(AuraType auratype) const
+{
+    return GetCachedAuraModifier(m_auraModifierCache, auratype, AuraModifierQuery::Total, 0, [](std::span<AuraEffect* const> effects)
+    {
+        int32 modifier = 0;
+
+        for (AuraEffect const* aurEff : effects)
+            modifier += aurEff->GetAmount();
+
+        return modifier;
+    });
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
-    float multiplier = 1.0f;
+    return GetCachedAuraModifier(m_auraMultiplierCache, auratype, AuraModifierQuery::Total, 0, [](std::span<AuraEffect* const> effects)
+    {
+        float multiplier = 1.0f;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        AddPct(multiplier, (*i)->GetAmount());
+        for (AuraEffect const* aurEff : effects)
+            AddPct(multiplier, aurEff->GetAmount());
 
-    return multiplier;
+        return multiplier;
+    });
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype)
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    return GetCachedAuraModifier(m_auraModifierCache, auratype, AuraModifierQuery::MaxPositive, 0, [](std::span<AuraEffect* const> effects)
     {
-        if ((*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
+        int32 modifier = 0;
 
-    return modifier;
+        for (AuraEffect const* aurEff : effects)
+        {
+            if (aurEff->GetAmount() > modifier)
+                modifier = aurEff->GetAmount();
+        }
+
+        return modifier;
+    });
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
+    return GetCachedAuraModifier(m_auraModifierCache, auratype, AuraModifierQuery::MaxNegative, 0, [](std::span<AuraEffect* const> effects)
+    {
+        int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
+        for (AuraEffect const* aurEff : effects)
+            if (aurEff->GetAmount() < modifier)
+                modifier = aurEff->GetAmount();
 
-    return modifier;
+        return modifier;
+    });
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    return GetCachedAuraModifier(m_auraModifierCache, auratype, AuraModifierQuery::TotalByMiscMask, misc_mask, [misc_mask](std::span<AuraEffect* const> effects)
     {
-        if ((*i)->GetMiscValue()& misc_mask)
-            modifier += (*i)->GetAmount();
-    }
-    return modifier;
+        int32 modifier = 0;
+
+        for (AuraEffect const* aurEff : effects)
+        {
+            if (aurEff->GetMiscValue() & misc_mask)
+                modifier += aurEff->GetAmount();
+        }
+
+        return modifier;
+    });
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    float multiplier = 1.0f;
+    return GetCachedAuraModifier(m_auraMultiplierCache, auratype, AuraModifierQuery::TotalByMiscMask, misc_mask, [misc_mask](std::span<AuraEffect* const> effects)
+    {
+        float multiplier = 1.0f;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if (((*i)->GetMiscValue() & misc_mask))
-            AddPct(multiplier, (*i)->GetAmount());
+        for (AuraEffect const* aurEff : effects)
+            if ((aurEff->GetMiscValue() & misc_mask))
+                AddPct(multiplier, aurEff->GetAmount());
 
-    return multiplier;
+        return multiplier;
+    });
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask, const AuraEffect* except) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    auto calculate = [misc_mask, except](std::span<AuraEffect* const> effects)
     {
-        if (except != (*i) && (*i)->GetMiscValue()& misc_mask && (*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
+        int32 modifier = 0;
 
-    return modifier;
+        for (AuraEffect const* aurEff : effects)
+        {
+            if (except != aurEff && aurEff->GetMiscValue() & misc_mask && aurEff->GetAmount() > modifier)
+                modifier = aurEff->GetAmount();
+        }
+
+        return modifier;
+    };
+
+    // results without an effect left out are the only ones worth keeping
+    if (except)
+        return calculate(GetAuraEffectSpanByType(auratype));
+
+    return GetCachedAuraModifier(m_auraModifierCache, auratype, AuraModifierQuery::MaxPositiveByMiscMask, misc_mask, calculate);
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    return GetCachedAuraModifier(m_auraModifierCache, auratype, AuraModifierQuery::MaxNegativeByMiscMask, misc_mask, [misc_mask](std::span<AuraEffect* const> effects)
     {
-        if ((*i)->GetMiscValue()& misc_mask && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-    }
+        int32 modifier = 0;
 
-    return modifier;
+        for (AuraEffect const* aurEff : effects)
+        {
+            if (aurEff->GetMiscValue() & misc_mask && aurEff->GetAmount() < modifier)
+                modifier = aurEff->GetAmount();
+        }
+
+        return modifier;
+    });
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
+    return GetCachedAuraModifier(m_auraModifierCache, auratype, AuraModifierQuery::TotalByMiscValue, uint32(misc_value), [misc_value](std::span<AuraEffect* const> effects)
+    {
+        int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetMiscValue() == misc_value)
-            modifier += (*i)->GetAmount();
+        for (AuraEffect const* aurEff : effects)
+            if (aurEff->GetMiscValue() == misc_value)
+                modifier += aurEff->GetAmount();
 
-    return modifier;
+        return modifier;
+    });
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    float multiplier = 1.0f;
+    return GetCachedAuraModifier(m_auraMultiplierCache, auratype, AuraModifierQuery::TotalByMiscValue, uint32(misc_value), [misc_value](std::span<AuraEffect* const> effects)
+    {
+        float multiplier = 1.0f;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetMiscValue() == misc_value)
-            AddPct(multiplier, (*i)->GetAmount());
+        for (AuraEffect const* aurEff : effects)
+            if (aurEff->GetMiscValue() == misc_value)
+                AddPct(multiplier, aurEff->GetAmount());
 
-    return multiplier;
+        return multiplier;
+    });
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    return GetCachedAuraModifier(m_auraModifierCache, auratype, AuraModifierQuery::MaxPositiveByMiscValue, uint32(misc_value), [misc_value](std::span<AuraEffect* const> effects)
     {
-        if ((*i)->GetMiscValue() == misc_value && (*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
+        int32 modifier = 0;
 
-    return modifier;
+        for (AuraEffect const* aurEff : effects)
+        {
+            if (aurEff->GetMiscValue() == misc_value && aurEff->GetAmount() > modifier)
+                modifier = aurEff->GetAmount();
+        }
+
+        return modifier;
+    });
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    return GetCachedAuraModifier(m_auraModifierCache, auratype, AuraModifierQuery::MaxNegativeByMiscValue, uint32(misc_value), [misc_value](std::span<AuraEffect* const> effects)
     {
-        if ((*i)->GetMiscValue() == misc_value && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-    }
+        int32 modifier = 0;
 
-    return modifier;
+        for (AuraEffect const* aurEff : effects)
+        {
+            if (aurEff->GetMiscValue() == misc_value && aurEff->GetAmount() < modifier)
+                modifier = aurEff->GetAmount();
+        }
+
+        return modifier;
+    });
 }
 
 int32 Unit::GetTotalAuraModifierByAffectMask(AuraType auratype, SpellInfo const* affectedSpell) const
 {
     int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->IsAffectedOnSpell(affectedSpell))
-            modifier += (*i)->GetAmount();
+    std::span<AuraEffect* const> mTotalAuraList = GetAuraEffectSpanByType(auratype);
+    for (AuraEffect const* aurEff : mTotalAuraList)
+        if (aurEff->IsAffectedOnSpell(affectedSpell))
+            modifier += aurEff->GetAmount();
 
     return modifier;
 }
@@ -6007,10 +6100,10 @@ float Unit::GetTotalAuraMultiplierByAffectMask(AuraType auratype, SpellInfo cons
 {
     float multiplier = 1.0f;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->IsAffectedOnSpell(affectedSpell))
-            AddPct(multiplier, (*i)->GetAmount());
+    std::span<AuraEffect* const> mTotalAuraList = GetAuraEffectSpanByType(auratype);
+    for (AuraEffect const* aurEff : mTotalAuraList)
+        if (aurEff->IsAffectedOnSpell(affectedSpell))
+            AddPct(multiplier, aurEff->GetAmount());
 
     return multiplier;
 }
@@ -6019,11 +6112,11 @@ int32 Unit::GetMaxPositiveAuraModifierByAffectMask(AuraType auratype, SpellInfo
 {
     int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    std::span<AuraEffect* const> mTotalAuraList = GetAuraEffectSpanByType(auratype);
+    for (AuraEffect const* aurEff : mTotalAuraList)
     {
-        if ((*i)->IsAffectedOnSpell(affectedSpell) && (*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
+        if (aurEff->IsAffectedOnSpell(affectedSpell) && aurEff->GetAmount() > modifier)
+            modifier = aurEff->GetAmount();
     }
 
     return modifier;
@@ -6033,11 +6126,11 @@ int32 Unit::GetMaxNegativeAuraModifierByAffectMask(AuraType auratype, SpellInfo
 {
     int32 modifier = 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
+    std::span<AuraEffect* const> mTotalAuraList = GetAuraEffectSpanByType(auratype);
+    for (AuraEffect const* aurEff : mTotalAuraList)
     {
-        if ((*i)->IsAffectedOnSpell(affectedSpell) && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
+        if (aurEff->IsAffectedOnSpell(affectedSpell) && aurEff->GetAmount() < modifier)
+            modifier = aurEff->GetAmount();
     }
 
     return modifier;
@@ -17241,6 +17334,7 @@ Unit* Unit::SelectNearbyTarget(Unit* exclude, float dist) const
     std::list<Unit*> targets;
     Warhead::AnyUnfriendlyUnitInObjectRangeCheck u_check(this, this, dist);
     Warhead::UnitListSearcher<Warhead::AnyUnfriendlyUnitInObjectRangeCheck> searcher(this, targets, u_check);
+    searcher.i_searchArea.Set(this, dist);
     Cell::VisitAllObjects(this, searcher, dist);
 
     // remove current target
@@ -19335,12 +19429,8 @@ void Unit::SetPhaseMask(uint32 newPhaseMask, bool update)
             if (GetTypeId() != TYPEID_PLAYER)
             {
                 ThreatContainer::StorageType threatList = GetThreatMgr().GetThreatList();
-                ThreatContainer::StorageType offlineThreatList = GetThreatMgr().GetOfflineThreatList();
-
-                // merge expects sorted lists
-                threatList.sort();
-                offlineThreatList.sort();
-                threatList.merge(offlineThreatList);
+                ThreatContainer::StorageType const& offlineThreatList = GetThreatMgr().GetOfflineThreatList();
+                threatList.insert(threatList.end(), offlineThreatList.begin(), offlineThreatList.end());
 
                 for (ThreatContainer::StorageType::const_iterator itr = threatList.begin(); itr != threatList.end(); ++itr)
                     if (Unit* unit = (*itr)->getTarget())
@@ -20776,7 +20866,7 @@ void Unit::ExecuteDelayedUnitRelocationEvent()
                     float dy = active->m_last_notify_position.GetPositionY() - active->GetPositionY();
                     float dz = active->m_last_notify_position.GetPositionZ() - active->GetPositionZ();
                     float distsq = dx * dx + dy * dy + dz * dz;
-                    float mindistsq = DynamicVisibilityMgr::GetReqMoveDistSq(active->FindMap()->GetEntry()->map_type);
+                    float mindistsq = active->FindMap()->GetDynamicVisibility().GetReqMoveDistSq();
                     if (distsq < mindistsq)
                         continue;
 
@@ -20801,6 +20891,7 @@ void Unit::ExecuteDelayedUnitRelocationEvent()
         if (viewPoint->GetMapId() != player->GetMapId() || !viewPoint->IsPositionValid() || !player->IsPositionValid())
             return;
 
+        float moveDist = -1.0f; // distance the player moved since the last notify, if known
         if (Unit* active = viewPoint->ToUnit())
         {
             if (active->IsVehicle())
@@ -20813,23 +20904,32 @@ void Unit::ExecuteDelayedUnitRelocationEvent()
                 float dz     = active->m_last_notify_position.GetPositionZ() - active->GetPositionZ();
                 float distsq = dx * dx + dy * dy + dz * dz;
 
-                float mindistsq = DynamicVisibilityMgr::GetReqMoveDistSq(active->FindMap()->GetEntry()->map_type);
+                float mindistsq = active->FindMap()->GetDynamicVisibility().GetReqMoveDistSq();
                 if (distsq < mindistsq)
                     return;
 
                 active->m_last_notify_position.Relocate(active->GetPositionX(), active->GetPositionY(), active->GetPositionZ());
+                if (active == player)
+                    moveDist = std::sqrt(distsq);
             }
         }
 
-        Warhead::PlayerRelocationNotifier relocateNoLarge(*player, false); // visit only objects which are not large; default distance
-        Cell::VisitAllObjects(viewPoint, relocateNoLarge, player->GetSightRange() + VISIBILITY_INC_FOR_GOBJECTS);
-        relocateNoLarge.SendToSelf();
-
-        if (!player->GetFarSightDistance())
+        if (moveDist >= 0.0f && player->CanUpdateVisibilityIncrementally(moveDist))
+            player->UpdateVisibilityIncrementally(moveDist);
+        else
         {
-            Warhead::PlayerRelocationNotifier relocateLarge(*player, true); // visit only large objects; maximum distance
-            Cell::VisitAllObjects(viewPoint, relocateLarge, MAX_VISIBILITY_DISTANCE);
-            relocateLarge.SendToSelf();
+            Warhead::PlayerRelocationNotifier relocateNoLarge(*player, false); // visit only objects which are not large; default distance
+            Cell::VisitAllObjects(viewPoint, relocateNoLarge, player->GetSightRange() + VISIBILITY_INC_FOR_GOBJECTS);
+            relocateNoLarge.SendToSelf();
+
+            if (!player->GetFarSightDistance())
+            {
+                Warhead::PlayerRelocationNotifier relocateLarge(*player, true); // visit only large objects; maximum distance
+                Cell::VisitAllObjects(viewPoint, relocateLarge, MAX_VISIBILITY_DISTANCE);
+                relocateLarge.SendToSelf();
+            }
+
+            player->SetFullVisibilityUpdateDone();
         }
 
         this->AddToNotify(NOTIFY_AI_RELOCATION);
@@ -20843,7 +20943,7 @@ void Unit::ExecuteDelayedUnitRelocationEvent()
         float dy = unit->m_last_notify_position.GetPositionY() - unit->GetPositionY();
         float dz = unit->m_last_notify_position.GetPositionZ() - unit->GetPositionZ();
         float distsq = dx * dx + dy * dy + dz * dz;
-        float mindistsq = DynamicVisibilityMgr::GetReqMoveDistSq(unit->FindMap()->GetEntry()->map_type);
+        float mindistsq = unit->FindMap()->GetDynamicVisibility().GetReqMoveDistSq();
         if (distsq < mindistsq)
             return;
 
@@ -21073,7 +21173,6 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
     if (plr && plr->IsInSameRaidWith(target))
         visibleFlag |= UF_FLAG_PARTY_MEMBER;
 
-    Creature const* creature = ToCreature();
     for (uint16 index = 0; index < m_valuesCount; ++index)
     {
         if (_fieldNotifyFlags & flags[index] ||
@@ -21083,40 +21182,15 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
         {
             updateMask.SetBit(index);
 
-            if (index == UNIT_NPC_FLAGS)
-            {
-                uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
-
-                if (creature)
-                {
-                    if (CONF_GET_INT("InstantFlightPaths") == 2 && appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
-                    {
-                        appendValue |= UNIT_NPC_FLAG_GOSSIP; // flight masters need NPC gossip flag to show instant flight toggle option
-                    }
-
-                    if (!target->CanSeeSpellClickOn(creature))
-                    {
-                        appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
-                    }
-
-                    if (!target->CanSeeVendor(creature))
-                    {
-                        appendValue &= ~UNIT_NPC_FLAG_VENDOR_MASK;
-                    }
-
-                    if (!creature->IsValidTrainerForPlayer(target, &appendValue))
-                    {
-                        appendValue &= ~UNIT_NPC_FLAG_TRAINER;
-                    }
-                }
-
-                fieldBuffer << uint32(appendValue);
-            }
-            else if (index == UNIT_FIELD_AURASTATE)
+            // FG: pretend that OTHER players in own group are friendly ("blue")
+            if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
             {
-                // Check per caster aura states to not enable using a spell in client if specified aura is not by target
-                fieldBuffer << BuildAuraStateUpdateForTarget(target);
+                uint32 value = m_uint32Values[index];
+                if (BuildFactionFieldForTarget(index, target, value) || !sScriptMgr->IsCustomBuildValuesUpdate(this, updateType, &fieldBuffer, target, index))
+                    fieldBuffer << value;
             }
+            else if (IsValuesUpdateFieldPerTarget(index))
+                fieldBuffer << GetValuesUpdateFieldForTarget(index, target);
             // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
             else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
             {
@@ -21131,128 +21205,202 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
             {
                 fieldBuffer << uint32(m_floatValues[index]);
             }
-            // Gamemasters should be always able to select units - remove not selectable flag
-            else if (index == UNIT_FIELD_FLAGS)
+            else
             {
-                uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
-                if (target->IsGameMaster() && AccountMgr::IsGMAccount(target->GetSession()->GetSecurity()))
-                    appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
+                if (sScriptMgr->OnBuildValuesUpdate(this, updateType, &fieldBuffer, target, index))
+                {
+                    continue;
+                }
 
-                fieldBuffer << uint32(appendValue);
+                // send in current format (float as float, uint32 as uint32)
+                fieldBuffer << m_uint32Values[index];
             }
-            // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
-            else if (index == UNIT_FIELD_DISPLAYID)
-            {
-                uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
-                if (creature)
-                {
-                    CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
+        }
+    }
 
-                    // this also applies for transform auras
-                    if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
-                        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
-                            if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
-                                if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
-                                {
-                                    cinfo = transformInfo;
-                                    break;
-                                }
+    *data << uint8(updateMask.GetBlockCount());
+    updateMask.AppendToPacket(data);
+    data->append(fieldBuffer);
+}
 
-                    if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
-                    {
-                        if (target->IsGameMaster() && AccountMgr::IsGMAccount(target->GetSession()->GetSecurity()))
-                        {
-                            if (cinfo->Modelid1)
-                                displayId = cinfo->Modelid1;    // Modelid1 is a visible model for gms
-                            else
-                                displayId = 17519;              // world visible trigger's model
-                        }
-                        else
-                        {
-                            if (cinfo->Modelid2)
-                                displayId = cinfo->Modelid2;    // Modelid2 is an invisible model for players
-                            else
-                                displayId = 11686;              // world invisible trigger's model
-                        }
-                    }
-                }
+bool Unit::IsValuesUpdateFieldPerTarget(uint16 index) const
+{
+    switch (index)
+    {
+        case UNIT_NPC_FLAGS:
+        case UNIT_FIELD_AURASTATE:
+        case UNIT_FIELD_FLAGS:
+        case UNIT_FIELD_DISPLAYID:
+        case UNIT_DYNAMIC_FLAGS:
+        case UNIT_FIELD_BYTES_2:
+        case UNIT_FIELD_FACTIONTEMPLATE:
+            return true;
+        default:
+            return false;
+    }
+}
 
-                fieldBuffer << uint32(displayId);
-            }
-            // hide lootable animation for unallowed players
-            else if (index == UNIT_DYNAMIC_FLAGS)
-            {
-                uint32 dynamicFlags = m_uint32Values[UNIT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+uint32 Unit::GetValuesUpdateFieldForTarget(uint16 index, Player* target) const
+{
+    Creature const* creature = ToCreature();
 
-                if (creature)
+    switch (index)
+    {
+        case UNIT_NPC_FLAGS:
+        {
+            uint32 appendValue = m_uint32Values[UNIT_NPC_FLAGS];
+
+            if (creature)
+            {
+                if (CONF_GET_INT("InstantFlightPaths") == 2 && appendValue & UNIT_NPC_FLAG_FLIGHTMASTER)
                 {
-                    if (creature->hasLootRecipient())
-                    {
-                        dynamicFlags |= UNIT_DYNFLAG_TAPPED;
-                        if (creature->isTappedBy(target))
-                            dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
-                    }
+                    appendValue |= UNIT_NPC_FLAG_GOSSIP; // flight masters need NPC gossip flag to show instant flight toggle option
+                }
 
-                    if (!target->isAllowedToLoot(creature))
-                        dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
+                if (!target->CanSeeSpellClickOn(creature))
+                {
+                    appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
                 }
 
-                // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
-                if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
-                    if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
-                        dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+                if (!target->CanSeeVendor(creature))
+                {
+                    appendValue &= ~UNIT_NPC_FLAG_VENDOR_MASK;
+                }
 
-                fieldBuffer << dynamicFlags;
+                if (!creature->IsValidTrainerForPlayer(target, &appendValue))
+                {
+                    appendValue &= ~UNIT_NPC_FLAG_TRAINER;
+                }
             }
-            // FG: pretend that OTHER players in own group are friendly ("blue")
-            else if (index == UNIT_FIELD_BYTES_2 || index == UNIT_FIELD_FACTIONTEMPLATE)
+
+            return appendValue;
+        }
+        // Check per caster aura states to not enable using a spell in client if specified aura is not by target
+        case UNIT_FIELD_AURASTATE:
+            return BuildAuraStateUpdateForTarget(target);
+        // Gamemasters should be always able to select units - remove not selectable flag
+        case UNIT_FIELD_FLAGS:
+        {
+            uint32 appendValue = m_uint32Values[UNIT_FIELD_FLAGS];
+            if (target->IsGameMaster() && AccountMgr::IsGMAccount(target->GetSession()->GetSecurity()))
+                appendValue &= ~UNIT_FLAG_NOT_SELECTABLE;
+
+            return appendValue;
+        }
+        // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
+        case UNIT_FIELD_DISPLAYID:
+        {
+            uint32 displayId = m_uint32Values[UNIT_FIELD_DISPLAYID];
+            if (creature)
             {
-                if (IsControlledByPlayer() && target != this && CONF_GET_BOOL("AllowTwoSide.Interaction.Group") && IsInRaidWith(target))
+                CreatureTemplate const* cinfo = creature->GetCreatureTemplate();
+
+                // this also applies for transform auras
+                if (SpellInfo const* transform = sSpellMgr->GetSpellInfo(getTransForm()))
+                    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+                        if (transform->Effects[i].IsAura(SPELL_AURA_TRANSFORM))
+                            if (CreatureTemplate const* transformInfo = sObjectMgr->GetCreatureTemplate(transform->Effects[i].MiscValue))
+                            {
+                                cinfo = transformInfo;
+                                break;
+                            }
+
+                if (cinfo->flags_extra & CREATURE_FLAG_EXTRA_TRIGGER)
                 {
-                    FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
-                    FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
-                    if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
+                    if (target->IsGameMaster() && AccountMgr::IsGMAccount(target->GetSession()->GetSecurity()))
                     {
-                        if (index == UNIT_FIELD_BYTES_2)
-                            // Allow targetting opposite faction in party when enabled in config
-                            fieldBuffer << (m_uint32Values[UNIT_FIELD_BYTES_2] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
+                        if (cinfo->Modelid1)
+                            displayId = cinfo->Modelid1;    // Modelid1 is a visible model for gms
                         else
-                            // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
-                            fieldBuffer << uint32(target->GetFaction());
+                            displayId = 17519;              // world visible trigger's model
                     }
                     else
-                        fieldBuffer << m_uint32Values[index];
-                }// pussywizard / Callmephil
-                else if (target->IsSpectator() && target->FindMap() && target->FindMap()->IsBattleArena() &&
-                         (this->GetTypeId() == TYPEID_PLAYER || this->GetTypeId() == TYPEID_UNIT || this->GetTypeId() == TYPEID_DYNAMICOBJECT))
-                {
-                    if (index == UNIT_FIELD_BYTES_2)
-                        fieldBuffer << (m_uint32Values[index] & 0xFFFFF2FF); // clear UNIT_BYTE2_FLAG_PVP, UNIT_BYTE2_FLAG_FFA_PVP, UNIT_BYTE2_FLAG_SANCTUARY
-                    else
-                        fieldBuffer << (uint32)target->GetFaction();
-                }
-                else
-                    if (!sScriptMgr->IsCustomBuildValuesUpdate(this, updateType, &fieldBuffer, target, index))
                     {
-                        fieldBuffer << m_uint32Values[index];
+                        if (cinfo->Modelid2)
+                            displayId = cinfo->Modelid2;    // Modelid2 is an invisible model for players
+                        else
+                            displayId = 11686;              // world invisible trigger's model
                     }
+                }
             }
-            else
+
+            return displayId;
+        }
+        // hide lootable animation for unallowed players
+        case UNIT_DYNAMIC_FLAGS:
+        {
+            uint32 dynamicFlags = m_uint32Values[UNIT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+
+            if (creature)
             {
-                if (sScriptMgr->OnBuildValuesUpdate(this, updateType, &fieldBuffer, target, index))
+                if (creature->hasLootRecipient())
                 {
-                    continue;
+                    dynamicFlags |= UNIT_DYNFLAG_TAPPED;
+                    if (creature->isTappedBy(target))
+                        dynamicFlags |= UNIT_DYNFLAG_TAPPED_BY_PLAYER;
                 }
 
-                // send in current format (float as float, uint32 as uint32)
-                fieldBuffer << m_uint32Values[index];
+                if (!target->isAllowedToLoot(creature))
+                    dynamicFlags &= ~UNIT_DYNFLAG_LOOTABLE;
             }
+
+            // unit UNIT_DYNFLAG_TRACK_UNIT should only be sent to caster of SPELL_AURA_MOD_STALKED auras
+            if (dynamicFlags & UNIT_DYNFLAG_TRACK_UNIT)
+                if (!HasAuraTypeWithCaster(SPELL_AURA_MOD_STALKED, target->GetGUID()))
+                    dynamicFlags &= ~UNIT_DYNFLAG_TRACK_UNIT;
+
+            return dynamicFlags;
         }
+        case UNIT_FIELD_BYTES_2:
+        case UNIT_FIELD_FACTIONTEMPLATE:
+        {
+            uint32 value = m_uint32Values[index];
+            BuildFactionFieldForTarget(index, target, value);
+            return value;
+        }
+        default:
+            return m_uint32Values[index];
     }
+}
 
-    *data << uint8(updateMask.GetBlockCount());
-    updateMask.AppendToPacket(data);
-    data->append(fieldBuffer);
+bool Unit::BuildFactionFieldForTarget(uint16 index, Player const* target, uint32& value) const
+{
+    if (IsControlledByPlayer() && target != this && CONF_GET_BOOL("AllowTwoSide.Interaction.Group") && IsInRaidWith(target))
+    {
+        FactionTemplateEntry const* ft1 = GetFactionTemplateEntry();
+        FactionTemplateEntry const* ft2 = target->GetFactionTemplateEntry();
+        if (ft1 && ft2 && !ft1->IsFriendlyTo(*ft2))
+        {
+            if (index == UNIT_FIELD_BYTES_2)
+                // Allow targetting opposite faction in party when enabled in config
+                value = (m_uint32Values[UNIT_FIELD_BYTES_2] & ((UNIT_BYTE2_FLAG_SANCTUARY /*| UNIT_BYTE2_FLAG_AURAS | UNIT_BYTE2_FLAG_UNK5*/) << 8)); // this flag is at uint8 offset 1 !!
+            else
+                // pretend that all other HOSTILE players have own faction, to allow follow, heal, rezz (trade wont work)
+                value = uint32(target->GetFaction());
+        }
+
+        return true;
+    }
+
+    // pussywizard / Callmephil
+    if (target->IsSpectator() && target->FindMap() && target->FindMap()->IsBattleArena() &&
+        (this->GetTypeId() == TYPEID_PLAYER || this->GetTypeId() == TYPEID_UNIT || this->GetTypeId() == TYPEID_DYNAMICOBJECT))
+    {
+        if (index == UNIT_FIELD_BYTES_2)
+            value = (m_uint32Values[index] & 0xFFFFF2FF); // clear UNIT_BYTE2_FLAG_PVP, UNIT_BYTE2_FLAG_FFA_PVP, UNIT_BYTE2_FLAG_SANCTUARY
+        else
+            value = (uint32)target->GetFaction();
+
+        return true;
+    }
+
+    return false;
+}
+
+bool Unit::CanShareValuesUpdate() const
+{
+    // unit scripts may write any field differently for every target
+    return !sScriptMgr->HasUnitScripts();
 }
 
 void Unit::BuildCooldownPacket(WorldPacket& data, uint8 flags, uint32 spellId, uint32 cooldown)
@@ -30,7 +30,10 @@
 #include "SpellAuraDefines.h"
 #include "SpellDefines.h"
 #include "ThreatMgr.h"
+#include <bitset>
 #include <functional>
+#include <span>
+#include <unordered_map>
 #include <utility>
 
 class TaskScheduler;
@@ -1923,6 +1926,7 @@ public:
     void _RemoveNoStackAurasDueToAura(Aura* aura);
     bool _IsNoStackAuraDueToAura(Aura* appliedAura, Aura* existingAura) const;
     void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+    void InvalidateAuraModifierCache(AuraType auraType);
 
     // m_ownedAuras container management
     AuraMap&       GetOwnedAuras()       { return m_ownedAuras; }
@@ -1979,6 +1983,8 @@ public:
     void _ApplyAllAuraStatMods();
 
     [[nodiscard]] AuraEffectList const& GetAuraEffectsByType(AuraType type) const { return m_modAuras[type]; }
+    // Same effects and order as GetAuraEffectsByType, from one contiguous array. Invalidated by any aura apply/remove
+    [[nodiscard]] std::span<AuraEffect* const> GetAuraEffectSpanByType(AuraType type) const;
     AuraList&       GetSingleCastAuras()       { return m_scAuras; }
     [[nodiscard]] AuraList const& GetSingleCastAuras() const { return m_scAuras; }
 
@@ -2483,6 +2489,10 @@ protected:
     explicit Unit (bool isWorldObject);
 
     void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+    [[nodiscard]] bool IsValuesUpdateFieldPerTarget(uint16 index) const override;
+    [[nodiscard]] uint32 GetValuesUpdateFieldForTarget(uint16 index, Player* target) const override;
+    [[nodiscard]] bool CanShareValuesUpdate() const override;
+    bool BuildFactionFieldForTarget(uint16 index, Player const* target, uint32& value) const;
 
     UnitAI* i_AI, *i_disabledAI;
 
@@ -2523,6 +2533,12 @@ protected:
     uint32 m_removedAurasCount;
 
     AuraEffectList m_modAuras[TOTAL_AURAS];
+    // m_modAuras as contiguous arrays, one per aura type applied to the unit so far, sorted by type
+    std::vector<std::pair<uint16, std::vector<AuraEffect*>>> m_modAuraArrays;
+    // Results of the GetTotal/GetMax aura modifier queries, dropped per aura type by InvalidateAuraModifierCache
+    mutable std::unordered_map<uint64, int32> m_auraModifierCache;
+    mutable std::unordered_map<uint64, float> m_auraMultiplierCache;
+    mutable std::bitset<TOTAL_AURAS> m_auraModifierCachedTypes;
     AuraList m_scAuras;                        // casted singlecast auras
     AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
     AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
@@ -2577,6 +2593,22 @@ private:
     [[nodiscard]] float GetCombatRatingReduction(CombatRating cr) const;
     [[nodiscard]] uint32 GetCombatRatingDamageReduction(CombatRating cr, float rate, float cap, uint32 damage) const;
 
+    enum class AuraModifierQuery : uint8
+    {
+        Total,
+        MaxPositive,
+        MaxNegative,
+        TotalByMiscMask,
+        MaxPositiveByMiscMask,
+        MaxNegativeByMiscMask,
+        TotalByMiscValue,
+        MaxPositiveByMiscValue,
+        MaxNegativeByMiscValue
+    };
+
+    template<class T, class Calculator>
+    T GetCachedAuraModifier(std::unordered_map<uint64, T>& cache, AuraType auraType, AuraModifierQuery query, uint32 misc, Calculator calculate) const;
+
 protected:
     void SetFeared(bool apply, Unit* fearedBy = nullptr, bool isFear = false);
     void SetConfused(bool apply);
@@ -41,26 +41,42 @@ void HashMapHolder<T>::Insert(T* o)
         || std::is_same<MotionTransport, T>::value,
         "Only Player and Motion Transport can be registered in global HashMapHolder");
 
+    // writers keep the whole container and the shard in sync, always locking in this order
     std::unique_lock<std::shared_mutex> lock(*GetLock());
-
     GetContainer()[o->GetGUID()] = o;
+
+    Shard& shard = GetShard(o->GetGUID());
+    std::unique_lock<std::shared_mutex> shardLock(shard.Lock);
+    shard.Objects[o->GetGUID()] = o;
 }
 
 template<class T>
 void HashMapHolder<T>::Remove(T* o)
 {
     std::unique_lock<std::shared_mutex> lock(*GetLock());
-
     GetContainer().erase(o->GetGUID());
+
+    Shard& shard = GetShard(o->GetGUID());
+    std::unique_lock<std::shared_mutex> shardLock(shard.Lock);
+    shard.Objects.erase(o->GetGUID());
 }
 
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    std::shared_lock<std::shared_mutex> lock(*GetLock());
+    Shard& shard = GetShard(guid);
+    std::shared_lock<std::shared_mutex> lock(shard.Lock);
 
-    typename MapType::iterator itr = GetContainer().find(guid);
-    return (itr != GetContainer().end()) ? itr->second : nullptr;
+    typename MapType::const_iterator itr = shard.Objects.find(guid);
+    return (itr != shard.Objects.end()) ? itr->second : nullptr;
+}
+
+template<class T>
+auto HashMapHolder<T>::GetShard(ObjectGuid guid) -> Shard&
+{
+    // guid counters are handed out sequentially, so the low bits spread objects evenly
+    static std::array<Shard, SHARD_COUNT> _shards;
+    return _shards[guid.GetCounter() % SHARD_COUNT];
 }
 
 template<class T>
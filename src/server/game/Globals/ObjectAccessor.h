@@ -22,6 +22,7 @@
 #include "GridDefines.h"
 #include "Object.h"
 #include "UpdateData.h"
+#include <array>
 #include <shared_mutex>
 #include <unordered_map>
 
@@ -47,15 +48,29 @@ public:
 
     typedef std::unordered_map<ObjectGuid, T*> MapType;
 
+    static constexpr std::size_t SHARD_COUNT = 32;
+
     static void Insert(T* o);
 
     static void Remove(T* o);
 
     static T* Find(ObjectGuid guid);
 
+    // whole container, only for walking all objects while holding GetLock()
     static MapType& GetContainer();
 
     static std::shared_mutex* GetLock();
+
+private:
+    // Find() only locks the shard owning the guid, so lookups from map, network and world threads
+    // neither serialize on GetLock() nor wait behind a walk of the whole container
+    struct alignas(64) Shard
+    {
+        std::shared_mutex Lock;
+        MapType Objects;
+    };
+
+    static Shard& GetShard(ObjectGuid guid);
 };
 
 namespace ObjectAccessor
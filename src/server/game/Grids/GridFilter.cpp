@@ -0,0 +1,248 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include "GridFilter.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define GRID_FILTER_X86
+#endif
+
+#if defined(GRID_FILTER_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GRID_FILTER_SSE2
+#include <emmintrin.h>
+#endif
+
+// AVX2 is compiled per function and only called after the runtime check
+#if defined(GRID_FILTER_SSE2) && (defined(__GNUC__) || defined(_MSC_VER))
+#define GRID_FILTER_AVX2
+#include <immintrin.h>
+#if defined(__GNUC__)
+#define GRID_FILTER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#include <intrin.h>
+#define GRID_FILTER_TARGET_AVX2
+#endif
+#endif
+
+namespace Warhead::GridFilter
+{
+    namespace
+    {
+        inline bool TestScalar(Query const& query, float x, float y, float size, uint32 phaseMask)
+        {
+            if (query.CheckPhase && !(phaseMask & query.PhaseMask) && phaseMask != query.PhaseMask)
+                return false;
+
+            if (query.Radius > 0.0f)
+            {
+                float dx = x - query.X;
+                float dy = y - query.Y;
+                float maxDist = query.AddObjectSize ? query.Radius + size : query.Radius;
+                // written as two products and a sum so it rounds like the vector versions
+                float distSq = dx * dx;
+                distSq += dy * dy;
+                if (!(distSq <= maxDist * maxDist))
+                    return false;
+            }
+
+            return true;
+        }
+
+        uint64 FilterScalar(Query const& query, float const* x, float const* y, float const* size, uint32 const* phaseMask, uint32 count)
+        {
+            uint64 hits = 0;
+            for (uint32 i = 0; i < count; ++i)
+                if (TestScalar(query, x[i], y[i], size[i], phaseMask[i]))
+                    hits |= uint64(1) << i;
+
+            return hits;
+        }
+
+#ifdef GRID_FILTER_SSE2
+        uint64 FilterSSE2(Query const& query, float const* x, float const* y, float const* size, uint32 const* phaseMask, uint32 count)
+        {
+            __m128 const centerX = _mm_set1_ps(query.X);
+            __m128 const centerY = _mm_set1_ps(query.Y);
+            __m128 const radius = _mm_set1_ps(query.Radius);
+            __m128i const queryPhase = _mm_set1_epi32(int32(query.PhaseMask));
+            __m128i const zero = _mm_setzero_si128();
+            bool const checkDist = query.Radius > 0.0f;
+
+            uint64 hits = 0;
+            uint32 i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128 pass = _mm_castsi128_ps(_mm_cmpeq_epi32(zero, zero));
+
+                if (query.CheckPhase)
+                {
+                    __m128i objPhase = _mm_loadu_si128(reinterpret_cast<__m128i const*>(phaseMask + i));
+                    __m128i shared = _mm_cmpeq_epi32(_mm_and_si128(objPhase, queryPhase), zero);
+                    __m128i equal = _mm_cmpeq_epi32(objPhase, queryPhase);
+                    // andnot(shared, ones) | equal
+                    __m128i phaseOk = _mm_or_si128(_mm_andnot_si128(shared, _mm_castps_si128(pass)), equal);
+                    pass = _mm_castsi128_ps(phaseOk);
+                }
+
+                if (checkDist)
+                {
+                    __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), centerX);
+                    __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), centerY);
+                    __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+                    __m128 maxDist = query.AddObjectSize ? _mm_add_ps(radius, _mm_loadu_ps(size + i)) : radius;
+                    pass = _mm_and_ps(pass, _mm_cmple_ps(distSq, _mm_mul_ps(maxDist, maxDist)));
+                }
+
+                hits |= uint64(_mm_movemask_ps(pass)) << i;
+            }
+
+            for (; i < count; ++i)
+                if (TestScalar(query, x[i], y[i], size[i], phaseMask[i]))
+                    hits |= uint64(1) << i;
+
+            return hits;
+        }
+#endif
+
+#ifdef GRID_FILTER_AVX2
+        GRID_FILTER_TARGET_AVX2 uint64 FilterAVX2(Query const& query, float const* x, float const* y, float const* size, uint32 const* phaseMask, uint32 count)
+        {
+            __m256 const centerX = _mm256_set1_ps(query.X);
+            __m256 const centerY = _mm256_set1_ps(query.Y);
+            __m256 const radius = _mm256_set1_ps(query.Radius);
+            __m256i const queryPhase = _mm256_set1_epi32(int32(query.PhaseMask));
+            __m256i const zero = _mm256_setzero_si256();
+            __m256i const ones = _mm256_cmpeq_epi32(zero, zero);
+            bool const checkDist = query.Radius > 0.0f;
+
+            uint64 hits = 0;
+            uint32 i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                __m256 pass = _mm256_castsi256_ps(ones);
+
+                if (query.CheckPhase)
+                {
+                    __m256i objPhase = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(phaseMask + i));
+                    __m256i shared = _mm256_cmpeq_epi32(_mm256_and_si256(objPhase, queryPhase), zero);
+                    __m256i equal = _mm256_cmpeq_epi32(objPhase, queryPhase);
+                    pass = _mm256_castsi256_ps(_mm256_or_si256(_mm256_andnot_si256(shared, ones), equal));
+                }
+
+                if (checkDist)
+                {
+                    __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), centerX);
+                    __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), centerY);
+                    __m256 distSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+                    __m256 maxDist = query.AddObjectSize ? _mm256_add_ps(radius, _mm256_loadu_ps(size + i)) : radius;
+                    pass = _mm256_and_ps(pass, _mm256_cmp_ps(distSq, _mm256_mul_ps(maxDist, maxDist), _CMP_LE_OQ));
+                }
+
+                hits |= uint64(uint32(_mm256_movemask_ps(pass))) << i;
+            }
+
+            for (; i < count; ++i)
+                if (TestScalar(query, x[i], y[i], size[i], phaseMask[i]))
+                    hits |= uint64(1) << i;
+
+            return hits;
+        }
+
+        bool CpuHasAVX2()
+        {
+#if defined(__GNUC__)
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#else
+            int regs[4];
+            __cpuid(regs, 0);
+            if (regs[0] < 7)
+                return false;
+
+            // the OS must save the ymm registers
+            __cpuid(regs, 1);
+            if (!(regs[2] & (1 << 27)) || (_xgetbv(0) & 6) != 6)
+                return false;
+
+            __cpuidex(regs, 7, 0);
+            return (regs[1] & (1 << 5)) != 0;
+#endif
+        }
+#endif
+
+        Implementation SelectBestImplementation()
+        {
+#ifdef GRID_FILTER_AVX2
+            if (CpuHasAVX2())
+                return Implementation::AVX2;
+#endif
+#ifdef GRID_FILTER_SSE2
+            return Implementation::SSE2;
+#else
+            return Implementation::Scalar;
+#endif
+        }
+
+        Implementation const BestImplementation = SelectBestImplementation();
+        FilterFunction const BestFunction = GetFunction(BestImplementation);
+    }
+
+    FilterFunction GetFunction(Implementation impl)
+    {
+        switch (impl)
+        {
+            case Implementation::Scalar:
+                return &FilterScalar;
+#ifdef GRID_FILTER_SSE2
+            case Implementation::SSE2:
+                return &FilterSSE2;
+#endif
+#ifdef GRID_FILTER_AVX2
+            case Implementation::AVX2:
+                return CpuHasAVX2() ? &FilterAVX2 : nullptr;
+#endif
+            default:
+                return nullptr;
+        }
+    }
+
+    Implementation GetBestImplementation()
+    {
+        return BestImplementation;
+    }
+
+    char const* GetImplementationName(Implementation impl)
+    {
+        switch (impl)
+        {
+            case Implementation::SSE2:
+                return "SSE2";
+            case Implementation::AVX2:
+                return "AVX2";
+            default:
+                return "Scalar";
+        }
+    }
+
+    uint64 Filter(Query const& query, float const* x, float const* y, float const* size, uint32 const* phaseMask, uint32 count)
+    {
+        return BestFunction(query, x, y, size, phaseMask, count);
+    }
+}
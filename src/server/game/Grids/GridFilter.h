@@ -0,0 +1,64 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GRIDFILTER_H
+#define _GRIDFILTER_H
+
+#include "Define.h"
+
+/*
+  Batch distance and phase test over the packed arrays of a GridPositionIndex.
+  A candidate passes when
+    - CheckPhase is false, or (phaseMask & PhaseMask) != 0, or phaseMask == PhaseMask
+    - Radius <= 0, or dx * dx + dy * dy <= r * r with r = Radius (+ object size if AddObjectSize)
+  The SIMD versions give bit for bit the same result as the scalar one.
+*/
+namespace Warhead::GridFilter
+{
+    static constexpr uint32 MAX_BATCH = 64;
+
+    enum class Implementation : uint8
+    {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    struct Query
+    {
+        float X{0.0f};
+        float Y{0.0f};
+        float Radius{0.0f};         // 0 - no distance test
+        bool AddObjectSize{true};   // false - measure to the object's center
+        bool CheckPhase{false};
+        uint32 PhaseMask{0};
+    };
+
+    // Tests count (<= MAX_BATCH) candidates, bit i of the result is set when candidate i passes
+    using FilterFunction = uint64(*)(Query const& query, float const* x, float const* y, float const* size, uint32 const* phaseMask, uint32 count);
+
+    // nullptr if the implementation is not compiled in or not supported by the cpu
+    WH_GAME_API FilterFunction GetFunction(Implementation impl);
+
+    // best implementation supported by the cpu, selected once at startup
+    WH_GAME_API Implementation GetBestImplementation();
+    WH_GAME_API char const* GetImplementationName(Implementation impl);
+
+    WH_GAME_API uint64 Filter(Query const& query, float const* x, float const* y, float const* size, uint32 const* phaseMask, uint32 count);
+}
+
+#endif
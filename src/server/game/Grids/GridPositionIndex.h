@@ -0,0 +1,132 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GRIDPOSITIONINDEX_H
+#define _GRIDPOSITIONINDEX_H
+
+#include "Define.h"
+#include <vector>
+
+/*
+  @class GridPositionIndex
+  Packed copy of the positions and phase masks of the objects linked into one
+  cell container. It is kept in sync by GridObject on add/remove and by
+  WorldObject on every relocation, phase or size change, so searchers can
+  discard objects out of phase or out of range scanning plain arrays instead
+  of chasing the intrusive list.
+*/
+template<class OBJECT>
+class GridPositionIndex
+{
+public:
+    struct Removal
+    {
+        uint32 Slot;    // slot of the removed entry
+        uint32 From;    // slot of the entry moved into it, Slot if none was moved
+    };
+
+    // While a scan runs the removals are logged, the scan finds the entries moved in front of its position
+    class ScanGuard
+    {
+    public:
+        explicit ScanGuard(GridPositionIndex const& index) : _index(index) { ++_index._scans; }
+        ~ScanGuard()
+        {
+            if (!--_index._scans)
+                _index._removals.clear();
+        }
+
+        ScanGuard(ScanGuard const&) = delete;
+        ScanGuard& operator=(ScanGuard const&) = delete;
+
+    private:
+        GridPositionIndex const& _index;
+    };
+
+    uint32 Insert(OBJECT* obj)
+    {
+        uint32 slot = uint32(_objects.size());
+        _objects.push_back(obj);
+        _x.push_back(0.0f);
+        _y.push_back(0.0f);
+        _z.push_back(0.0f);
+        _size.push_back(0.0f);
+        _phaseMask.push_back(0);
+        Update(slot, obj);
+        return slot;
+    }
+
+    // swaps the last entry into the freed slot
+    void Remove(uint32 slot)
+    {
+        uint32 last = uint32(_objects.size()) - 1;
+        if (_scans)
+            _removals.push_back({ slot, last });
+
+        if (slot != last)
+        {
+            _objects[slot] = _objects[last];
+            _x[slot] = _x[last];
+            _y[slot] = _y[last];
+            _z[slot] = _z[last];
+            _size[slot] = _size[last];
+            _phaseMask[slot] = _phaseMask[last];
+            _objects[slot]->SetGridIndexSlot(slot);
+        }
+
+        _objects.pop_back();
+        _x.pop_back();
+        _y.pop_back();
+        _z.pop_back();
+        _size.pop_back();
+        _phaseMask.pop_back();
+    }
+
+    void Update(uint32 slot, OBJECT const* obj)
+    {
+        _x[slot] = obj->GetPositionX();
+        _y[slot] = obj->GetPositionY();
+        _z[slot] = obj->GetPositionZ();
+        _size[slot] = obj->GetObjectSize();
+        _phaseMask[slot] = obj->GetPhaseMask();
+    }
+
+    [[nodiscard]] uint32 Size() const { return uint32(_objects.size()); }
+    [[nodiscard]] OBJECT* GetObject(uint32 slot) const { return _objects[slot]; }
+
+    [[nodiscard]] float const* GetX() const { return _x.data(); }
+    [[nodiscard]] float const* GetY() const { return _y.data(); }
+    [[nodiscard]] float const* GetZ() const { return _z.data(); }
+    [[nodiscard]] float const* GetObjectSize() const { return _size.data(); }
+    [[nodiscard]] uint32 const* GetPhaseMask() const { return _phaseMask.data(); }
+
+    // removals since the outermost running scan started
+    [[nodiscard]] uint32 GetRemovalCount() const { return uint32(_removals.size()); }
+    [[nodiscard]] Removal const& GetRemoval(uint32 index) const { return _removals[index]; }
+
+private:
+    std::vector<OBJECT*> _objects;
+    std::vector<float> _x;
+    std::vector<float> _y;
+    std::vector<float> _z;
+    std::vector<float> _size;     // WorldObject::GetObjectSize()
+    std::vector<uint32> _phaseMask;
+    mutable std::vector<Removal> _removals;
+    mutable uint32 _scans{ 0 };
+};
+
+#endif
@@ -18,6 +18,7 @@
 #ifndef _GRIDREFMANAGER
 #define _GRIDREFMANAGER
 
+#include "GridPositionIndex.h"
 #include "RefMgr.h"
 
 template<class OBJECT>
@@ -36,5 +37,11 @@ public:
     iterator end() { return iterator(nullptr); }
     iterator rbegin() { return iterator(getLast()); }
     iterator rend() { return iterator(nullptr); }
+
+    GridPositionIndex<OBJECT>& GetPositionIndex() { return _positionIndex; }
+    [[nodiscard]] GridPositionIndex<OBJECT> const& GetPositionIndex() const { return _positionIndex; }
+
+private:
+    GridPositionIndex<OBJECT> _positionIndex;
 };
 #endif
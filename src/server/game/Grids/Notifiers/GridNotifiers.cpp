@@ -181,6 +181,58 @@ void PlayerRelocationNotifier::Visit(PlayerMapType& m)
     }
 }
 
+bool IncrementalVisibleNotifier::MayHaveChanged(WorldObject const* viewer, WorldObject const* target) const
+{
+    // stealth detection depends on distance and facing, passengers and vehicle accessories are measured in transport space
+    if (target->m_stealth.GetFlags() || target->GetTransport() || (target->ToUnit() && target->ToUnit()->GetVehicleBase()))
+        return true;
+
+    // the distance between the bounding spheres changed by at most i_moveDist, see WorldObject::_IsWithinDist
+    float edge = viewer->GetSightRange(target) + viewer->GetObjectSize() + target->GetObjectSize();
+    return std::fabs(viewer->GetExactDist(target) - edge) <= i_moveDist + 0.1f;
+}
+
+void IncrementalVisibleNotifier::Visit(GameObjectMapType& m)
+{
+    // gameobjects are measured against their display box
+    for (GameObjectMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        GameObject* go = iter->GetSource();
+        if (!go->IsVisibilityOverridden())
+            i_player.UpdateVisibilityOf(go, i_data, i_visibleNow);
+    }
+}
+
+void IncrementalVisibleNotifier::Visit(PlayerMapType& m)
+{
+    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        Player* player = iter->GetSource();
+        if (player == &i_player)
+            continue;
+
+        if (MayHaveChanged(&i_player, player))
+            i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
+
+        // the other player does not look from its own position or checks more than the distance
+        if (player->GetViewpoint() || player->GetFarSightDistance() || !player->IsAlive() || player->GetTransport() || player->GetVehicleBase() || MayHaveChanged(player, &i_player))
+            player->UpdateVisibilityOf(&i_player);
+    }
+}
+
+void IncrementalVisibleNotifier::SendToSelf()
+{
+    if (!i_data.HasData())
+        return;
+
+    WorldPacket packet;
+    i_data.BuildPacket(&packet);
+    i_player.GetSession()->SendPacket(&packet);
+
+    for (Unit* unit : i_visibleNow)
+        i_player.GetInitialVisiblePackets(unit);
+}
+
 void CreatureRelocationNotifier::Visit(PlayerMapType& m)
 {
     for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
@@ -215,14 +267,10 @@ void AIRelocationNotifier::Visit(CreatureMapType& m)
 
 void MessageDistDeliverer::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Player* target)
     {
-        Player* target = iter->GetSource();
-        if (!target->InSamePhase(i_phaseMask))
-            continue;
-
         if (target->GetExactDist2dSq(i_source) > i_distSq)
-            continue;
+            return false;
 
         // Send packet to all who are sharing the player's vision
         if (target->HasSharedVision())
@@ -235,60 +283,60 @@ void MessageDistDeliverer::Visit(PlayerMapType& m)
 
         if (target->m_seer == target || target->GetVehicle())
             SendPacket(target);
-    }
+
+        return false;
+    });
 }
 
 void MessageDistDeliverer::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Creature* target)
     {
-        Creature* target = iter->GetSource();
-        if (!target->HasSharedVision() || !target->InSamePhase(i_phaseMask))
-            continue;
+        if (!target->HasSharedVision())
+            return false;
 
         if (target->GetExactDist2dSq(i_source) > i_distSq)
-            continue;
+            return false;
 
         // Send packet to all who are sharing the creature's vision
         SharedVisionList::const_iterator i = target->GetSharedVisionList().begin();
         for (; i != target->GetSharedVisionList().end(); ++i)
             if ((*i)->m_seer == target)
                 SendPacket(*i);
-    }
+
+        return false;
+    });
 }
 
 void MessageDistDeliverer::Visit(DynamicObjectMapType& m)
 {
-    for (DynamicObjectMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](DynamicObject* target)
     {
-        DynamicObject* target = iter->GetSource();
-        if (!target->GetCasterGUID().IsPlayer() || !target->InSamePhase(i_phaseMask))
-            continue;
+        if (!target->GetCasterGUID().IsPlayer())
+            return false;
 
         // Xinef: Check whether the dynobject allows to see through it
         if (!target->IsViewpoint())
-            continue;
+            return false;
 
         if (target->GetExactDist2dSq(i_source) > i_distSq)
-            continue;
+            return false;
 
         // Send packet back to the caster if the caster has vision of dynamic object
         Player* caster = (Player*)target->GetCaster();
         if (caster && caster->m_seer == target)
             SendPacket(caster);
-    }
+
+        return false;
+    });
 }
 
 void MessageDistDelivererToHostile::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Player* target)
     {
-        Player* target = iter->GetSource();
-        if (!target->InSamePhase(i_phaseMask))
-            continue;
-
         if (target->GetExactDist2dSq(i_source) > i_distSq)
-            continue;
+            return false;
 
         // Send packet to all who are sharing the player's vision
         if (target->HasSharedVision())
@@ -301,44 +349,48 @@ void MessageDistDelivererToHostile::Visit(PlayerMapType& m)
 
         if (target->m_seer == target || target->GetVehicle())
             SendPacket(target);
-    }
+
+        return false;
+    });
 }
 
 void MessageDistDelivererToHostile::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Creature* target)
     {
-        Creature* target = iter->GetSource();
-        if (!target->HasSharedVision() || !target->InSamePhase(i_phaseMask))
-            continue;
+        if (!target->HasSharedVision())
+            return false;
 
         if (target->GetExactDist2dSq(i_source) > i_distSq)
-            continue;
+            return false;
 
         // Send packet to all who are sharing the creature's vision
         SharedVisionList::const_iterator i = target->GetSharedVisionList().begin();
         for (; i != target->GetSharedVisionList().end(); ++i)
             if ((*i)->m_seer == target)
                 SendPacket(*i);
-    }
+
+        return false;
+    });
 }
 
 void MessageDistDelivererToHostile::Visit(DynamicObjectMapType& m)
 {
-    for (DynamicObjectMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](DynamicObject* target)
     {
-        DynamicObject* target = iter->GetSource();
-        if (!target->GetCasterGUID().IsPlayer() || !target->InSamePhase(i_phaseMask))
-            continue;
+        if (!target->GetCasterGUID().IsPlayer())
+            return false;
 
         if (target->GetExactDist2dSq(i_source) > i_distSq)
-            continue;
+            return false;
 
         // Send packet back to the caster if the caster has vision of dynamic object
         Player* caster = (Player*)target->GetCaster();
         if (caster && caster->m_seer == target)
             SendPacket(caster);
-    }
+
+        return false;
+    });
 }
 
 template<class T>
@@ -354,6 +406,26 @@ void ObjectUpdater::Visit(GridRefMgr<T>& m)
     }
 }
 
+template<class T>
+void ShardedObjectUpdater::Visit(GridRefMgr<T>& m)
+{
+    T* obj;
+    for (typename GridRefMgr<T>::iterator iter = m.begin(); iter != m.end(); )
+    {
+        obj = iter->GetSource();
+        ++iter;
+
+        // large objects are updated by the map thread in the large cells pass
+        if (!obj->IsInWorld() || obj->IsVisibilityOverridden())
+            continue;
+
+        if (Map::CanUpdateInShard(obj))
+            obj->Update(i_timeDiff);
+        else
+            i_deferred.push_back(obj->GetGUID());
+    }
+}
+
 bool AnyDeadUnitObjectInRangeCheck::operator()(Player* u)
 {
     return !u->IsAlive() && !u->HasAuraType(SPELL_AURA_GHOST) && i_searchObj->IsWithinDistInMap(u, i_range);
@@ -386,4 +458,7 @@ bool AnyDeadUnitSpellTargetInRangeCheck::operator()(Creature* u)
 
 template void ObjectUpdater::Visit<Creature>(CreatureMapType&);
 template void ObjectUpdater::Visit<GameObject>(GameObjectMapType&);
-template void ObjectUpdater::Visit<DynamicObject>(DynamicObjectMapType&);
\ No newline at end of file
+template void ObjectUpdater::Visit<DynamicObject>(DynamicObjectMapType&);
+template void ShardedObjectUpdater::Visit<Creature>(CreatureMapType&);
+template void ShardedObjectUpdater::Visit<GameObject>(GameObjectMapType&);
+template void ShardedObjectUpdater::Visit<DynamicObject>(DynamicObjectMapType&);
\ No newline at end of file
@@ -22,6 +22,7 @@
 #include "CreatureAI.h"
 #include "DynamicObject.h"
 #include "GameObject.h"
+#include "GridFilter.h"
 #include "Group.h"
 #include "Object.h"
 #include "ObjectGridLoader.h"
@@ -30,11 +31,139 @@
 #include "Spell.h"
 #include "Unit.h"
 #include "UpdateData.h"
+#include <bit>
 
 class Player;
 
 namespace Warhead
 {
+    // optional distance pre-filter of the searchers, callers set it when their check uses the same range
+    struct GridSearchArea
+    {
+        float X{0.0f};
+        float Y{0.0f};
+        float Radius{0.0f}; // 0 - no distance filter, all objects of the visited cells are checked
+        bool ObjectBounds{true};
+
+        // skips objects whose bounding circle is farther than range from the center's one
+        void Set(WorldObject const* center, float range)
+        {
+            Set(center->GetPositionX(), center->GetPositionY(), range + center->GetObjectSize());
+        }
+
+        // skips objects whose bounding circle is farther than radius from x, y
+        void Set(float x, float y, float radius)
+        {
+            X = x;
+            Y = y;
+            Radius = radius;
+            ObjectBounds = true;
+        }
+
+        // skips objects whose position is farther than dist from x, y, same as GetExactDist2dSq() > dist * dist
+        void SetExact(float x, float y, float dist)
+        {
+            X = x;
+            Y = y;
+            Radius = dist;
+            ObjectBounds = false;
+        }
+    };
+
+    // Scans the packed GridPositionIndex of a cell container and calls callback only for objects that may be
+    // in phase and inside the search area, the callback returns true to stop the search.
+    // Pass no phase mask for searchers which leave the phase check to their check.
+    template<class T, class Callback>
+    inline void VisitGridCandidates(GridRefMgr<T>& m, Optional<uint32> phaseMask, GridSearchArea const& area, Callback&& callback)
+    {
+        GridPositionIndex<T> const& index = m.GetPositionIndex();
+
+        // the phase test is a superset of WorldObject::InSamePhase for both phase modes, the exact check follows
+        GridFilter::Query query;
+        query.X = area.X;
+        query.Y = area.Y;
+        query.Radius = area.Radius;
+        query.AddObjectSize = area.ObjectBounds;
+        query.CheckPhase = phaseMask.has_value();
+        query.PhaseMask = phaseMask.value_or(0);
+
+        // A callback removing an object moves the last entry of the index into the freed slot. Entries not
+        // visited yet which land in front of the scanned slots are queued and visited out of order
+        typename GridPositionIndex<T>::ScanGuard scan(index);
+        std::vector<uint32> pending;
+
+        auto collectMoved = [&index, &pending](uint32 removals, uint32 scanned) -> bool
+        {
+            if (index.GetRemovalCount() == removals)
+                return false;
+
+            for (; removals < index.GetRemovalCount(); ++removals)
+            {
+                auto const& removal = index.GetRemoval(removals);
+                std::erase(pending, removal.Slot);
+
+                if (removal.Slot == removal.From)
+                    continue;
+
+                bool unvisited = removal.From >= scanned || std::erase(pending, removal.From);
+                if (unvisited && removal.Slot < scanned)
+                    pending.push_back(removal.Slot);
+            }
+
+            return true;
+        };
+
+        uint32 next = 0;
+        while (next < index.Size() || !pending.empty())
+        {
+            if (!pending.empty())
+            {
+                uint32 slot = pending.back();
+                pending.pop_back();
+
+                if (!GridFilter::Filter(query, index.GetX() + slot, index.GetY() + slot, index.GetObjectSize() + slot, index.GetPhaseMask() + slot, 1))
+                    continue;
+
+                T* obj = index.GetObject(slot);
+                if (phaseMask && !obj->InSamePhase(*phaseMask))
+                    continue;
+
+                uint32 removals = index.GetRemovalCount();
+                if (callback(obj))
+                    return;
+
+                collectMoved(removals, next);
+                continue;
+            }
+
+            uint32 base = next;
+            uint32 count = std::min<uint32>(index.Size() - base, GridFilter::MAX_BATCH);
+            uint64 hits = GridFilter::Filter(query, index.GetX() + base, index.GetY() + base, index.GetObjectSize() + base, index.GetPhaseMask() + base, count);
+            next = base + count;
+
+            while (hits)
+            {
+                uint32 i = base + uint32(std::countr_zero(hits));
+                hits &= hits - 1;
+
+                T* obj = index.GetObject(i);
+                if (phaseMask && !obj->InSamePhase(*phaseMask))
+                    continue;
+
+                uint32 removals = index.GetRemovalCount();
+                if (callback(obj))
+                    return;
+
+                // the rest of the batch is stale after a removal, added objects are appended and found by the next batch
+                if (collectMoved(removals, i + 1))
+                {
+                    next = i + 1;
+                    break;
+                }
+            }
+        }
+    }
+
     struct VisibleNotifier
     {
         Player& i_player;
@@ -55,6 +184,31 @@ namespace Warhead
         void SendToSelf(void);
     };
 
+    // Re-checks after a short move of the player only the objects whose visibility may have changed since the
+    // last check: objects whose bounding sphere is within the moved distance of the sight range edge, stealthed
+    // objects and objects not measured by a plain distance (gameobjects, passengers). Large objects and objects
+    // which went out of the visited cells are left to the full rescans done on cell crossings and periodically.
+    struct IncrementalVisibleNotifier
+    {
+        Player& i_player;
+        float i_moveDist;
+        std::vector<Unit*>& i_visibleNow;
+        UpdateData i_data;
+
+        IncrementalVisibleNotifier(Player& player, float moveDist) :
+            i_player(player), i_moveDist(moveDist), i_visibleNow(player.m_newVisible)
+        {
+            i_visibleNow.clear();
+        }
+
+        void Visit(GameObjectMapType&);
+        void Visit(PlayerMapType&);
+        template<class T> void Visit(GridRefMgr<T>& m);
+        void SendToSelf();
+
+        [[nodiscard]] bool MayHaveChanged(WorldObject const* viewer, WorldObject const* target) const;
+    };
+
     struct VisibleChangesNotifier
     {
         WorldObject& i_object;
@@ -94,16 +248,18 @@ namespace Warhead
     struct MessageDistDeliverer
     {
         WorldObject const* i_source;
-        WorldPacket const* i_message;
+        SharedWorldPacket i_message;
         uint32 i_phaseMask;
         float i_distSq;
+        GridSearchArea i_searchArea;
         TeamId teamId;
         Player const* skipped_receiver;
         MessageDistDeliverer(WorldObject const* src, WorldPacket const* msg, float dist, bool own_team_only = false, Player const* skipped = nullptr)
-            : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
+            : i_source(src), i_message(*msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
             , teamId((own_team_only && src->GetTypeId() == TYPEID_PLAYER) ? src->ToPlayer()->GetTeamId() : TEAM_NEUTRAL)
             , skipped_receiver(skipped)
         {
+            i_searchArea.SetExact(src->GetPositionX(), src->GetPositionY(), dist);
         }
         void Visit(PlayerMapType& m);
         void Visit(CreatureMapType& m);
@@ -126,12 +282,14 @@ namespace Warhead
     struct MessageDistDelivererToHostile
     {
         Unit* i_source;
-        WorldPacket* i_message;
+        SharedWorldPacket i_message;
         uint32 i_phaseMask;
         float i_distSq;
+        GridSearchArea i_searchArea;
         MessageDistDelivererToHostile(Unit* src, WorldPacket* msg, float dist)
-            : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
+            : i_source(src), i_message(*msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
         {
+            i_searchArea.SetExact(src->GetPositionX(), src->GetPositionY(), dist);
         }
         void Visit(PlayerMapType& m);
         void Visit(CreatureMapType& m);
@@ -158,6 +316,17 @@ namespace Warhead
         void Visit(CorpseMapType&) {}
     };
 
+    // Updates objects of one region in a sharded map update, objects which can reach outside of the region are handed back
+    struct ShardedObjectUpdater
+    {
+        uint32 i_timeDiff;
+        std::vector<ObjectGuid>& i_deferred;
+        explicit ShardedObjectUpdater(const uint32 diff, std::vector<ObjectGuid>& deferred) : i_timeDiff(diff), i_deferred(deferred) {}
+        template<class T> void Visit(GridRefMgr<T>& m);
+        void Visit(PlayerMapType&) {}
+        void Visit(CorpseMapType&) {}
+    };
+
     // SEARCHERS & LIST SEARCHERS & WORKERS
 
     // WorldObject searchers & workers
@@ -195,6 +364,7 @@ namespace Warhead
         uint32 i_phaseMask;
         WorldObject*& i_object;
         Check& i_check;
+        GridSearchArea i_searchArea;
 
         WorldObjectSearcher(WorldObject const* searcher, WorldObject*& result, Check& check, uint32 mapTypeMask = GRID_MAP_TYPE_MASK_ALL)
             : i_mapTypeMask(mapTypeMask), i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
@@ -215,6 +385,7 @@ namespace Warhead
         uint32 i_phaseMask;
         WorldObject*& i_object;
         Check& i_check;
+        GridSearchArea i_searchArea;
 
         WorldObjectLastSearcher(WorldObject const* searcher, WorldObject*& result, Check& check, uint32 mapTypeMask = GRID_MAP_TYPE_MASK_ALL)
             :  i_mapTypeMask(mapTypeMask), i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
@@ -234,6 +405,7 @@ namespace Warhead
         uint32 i_mapTypeMask;
         uint32 i_phaseMask;
         Check& i_check;
+        GridSearchArea i_searchArea;
 
         template<typename Container>
         WorldObjectListSearcher(WorldObject const* searcher, Container& container, Check & check, uint32 mapTypeMask = GRID_MAP_TYPE_MASK_ALL)
@@ -314,6 +486,7 @@ namespace Warhead
         uint32 i_phaseMask;
         GameObject*& i_object;
         Check& i_check;
+        GridSearchArea i_searchArea;
 
         GameObjectSearcher(WorldObject const* searcher, GameObject*& result, Check& check)
             : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
@@ -330,6 +503,7 @@ namespace Warhead
         uint32 i_phaseMask;
         GameObject*& i_object;
         Check& i_check;
+        GridSearchArea i_searchArea;
 
         GameObjectLastSearcher(WorldObject const* searcher, GameObject*& result, Check& check)
             : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
@@ -344,6 +518,7 @@ namespace Warhead
     {
         uint32 i_phaseMask;
         Check& i_check;
+        GridSearchArea i_searchArea;
 
         template<typename Container>
         GameObjectListSearcher(WorldObject const* searcher, Container& container, Check & check)
@@ -384,6 +559,7 @@ namespace Warhead
         uint32 i_phaseMask;
         Unit*& i_object;
         Check& i_check;
+        GridSearchArea i_searchArea;
 
         UnitSearcher(WorldObject const* searcher, Unit*& result, Check& check)
             : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
@@ -401,6 +577,7 @@ namespace Warhead
         uint32 i_phaseMask;
         Unit*& i_object;
         Check& i_check;
+        GridSearchArea i_searchArea;
 
         UnitLastSearcher(WorldObject const* searcher, Unit*& result, Check& check)
             : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
@@ -417,6 +594,7 @@ namespace Warhead
     {
         uint32 i_phaseMask;
         Check& i_check;
+        GridSearchArea i_searchArea;
 
         template<typename Container>
         UnitListSearcher(WorldObject const* searcher, Container& container, Check& check)
@@ -437,6 +615,7 @@ namespace Warhead
         uint32 i_phaseMask;
         Creature*& i_object;
         Check& i_check;
+        GridSearchArea i_searchArea;
 
         CreatureSearcher(WorldObject const* searcher, Creature*& result, Check& check)
             : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
@@ -453,6 +632,7 @@ namespace Warhead
         uint32 i_phaseMask;
         Creature*& i_object;
         Check& i_check;
+        GridSearchArea i_searchArea;
 
         CreatureLastSearcher(WorldObject const* searcher, Creature*& result, Check& check)
             : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
@@ -467,6 +647,7 @@ namespace Warhead
     {
         uint32 i_phaseMask;
         Check& i_check;
+        GridSearchArea i_searchArea;
 
         template<typename Container>
         CreatureListSearcher(WorldObject const* searcher, Container& container, Check & check)
@@ -505,6 +686,7 @@ namespace Warhead
         uint32 i_phaseMask;
         Player*& i_object;
         Check& i_check;
+        GridSearchArea i_searchArea;
 
         PlayerSearcher(WorldObject const* searcher, Player*& result, Check& check)
             : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check) {}
@@ -519,6 +701,7 @@ namespace Warhead
     {
         uint32 i_phaseMask;
         Check& i_check;
+        GridSearchArea i_searchArea;
 
         template<typename Container>
         PlayerListSearcher(WorldObject const* searcher, Container& container, Check & check)
@@ -552,6 +735,7 @@ namespace Warhead
         uint32 i_phaseMask;
         Player*& i_object;
         Check& i_check;
+        GridSearchArea i_searchArea;
 
         PlayerLastSearcher(WorldObject const* searcher, Player*& result, Check& check) : i_phaseMask(searcher->GetPhaseMask()), i_object(result), i_check(check)
         {
@@ -43,6 +43,19 @@ inline void Warhead::VisibleNotifier::Visit(GridRefMgr<T>& m)
     }
 }
 
+template<class T>
+inline void Warhead::IncrementalVisibleNotifier::Visit(GridRefMgr<T>& m)
+{
+    for (typename GridRefMgr<T>::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        T* obj = iter->GetSource();
+        if (obj->IsVisibilityOverridden() || !MayHaveChanged(&i_player, obj))
+            continue;
+
+        i_player.UpdateVisibilityOf(obj, i_data, i_visibleNow);
+    }
+}
+
 // SEARCHERS & LIST SEARCHERS & WORKERS
 
 // WorldObject searchers & workers
@@ -57,17 +70,14 @@ void Warhead::WorldObjectSearcher<Check>::Visit(GameObjectMapType& m)
     if (i_object)
         return;
 
-    for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](GameObject* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!i_check(obj))
+            return false;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = obj;
+        return true;
+    });
 }
 
 template<class Check>
@@ -80,17 +90,14 @@ void Warhead::WorldObjectSearcher<Check>::Visit(PlayerMapType& m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Player* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!i_check(obj))
+            return false;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = obj;
+        return true;
+    });
 }
 
 template<class Check>
@@ -103,17 +110,14 @@ void Warhead::WorldObjectSearcher<Check>::Visit(CreatureMapType& m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Creature* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!i_check(obj))
+            return false;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = obj;
+        return true;
+    });
 }
 
 template<class Check>
@@ -126,17 +130,14 @@ void Warhead::WorldObjectSearcher<Check>::Visit(CorpseMapType& m)
     if (i_object)
         return;
 
-    for (CorpseMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Corpse* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!i_check(obj))
+            return false;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = obj;
+        return true;
+    });
 }
 
 template<class Check>
@@ -149,17 +150,14 @@ void Warhead::WorldObjectSearcher<Check>::Visit(DynamicObjectMapType& m)
     if (i_object)
         return;
 
-    for (DynamicObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](DynamicObject* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!i_check(obj))
+            return false;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = obj;
+        return true;
+    });
 }
 
 template<class Check>
@@ -168,14 +166,13 @@ void Warhead::WorldObjectLastSearcher<Check>::Visit(GameObjectMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_GAMEOBJECT))
         return;
 
-    for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](GameObject* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (i_check(obj))
+            i_object = obj;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        return false;
+    });
 }
 
 template<class Check>
@@ -184,14 +181,13 @@ void Warhead::WorldObjectLastSearcher<Check>::Visit(PlayerMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_PLAYER))
         return;
 
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Player* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (i_check(obj))
+            i_object = obj;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        return false;
+    });
 }
 
 template<class Check>
@@ -200,14 +196,13 @@ void Warhead::WorldObjectLastSearcher<Check>::Visit(CreatureMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CREATURE))
         return;
 
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Creature* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (i_check(obj))
+            i_object = obj;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        return false;
+    });
 }
 
 template<class Check>
@@ -216,14 +211,13 @@ void Warhead::WorldObjectLastSearcher<Check>::Visit(CorpseMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CORPSE))
         return;
 
-    for (CorpseMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Corpse* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (i_check(obj))
+            i_object = obj;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        return false;
+    });
 }
 
 template<class Check>
@@ -232,14 +226,13 @@ void Warhead::WorldObjectLastSearcher<Check>::Visit(DynamicObjectMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_DYNAMICOBJECT))
         return;
 
-    for (DynamicObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](DynamicObject* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (i_check(obj))
+            i_object = obj;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        return false;
+    });
 }
 
 template<class Check>
@@ -248,9 +241,13 @@ void Warhead::WorldObjectListSearcher<Check>::Visit(PlayerMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_PLAYER))
         return;
 
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->GetSource()))
-            Insert(itr->GetSource());
+    VisitGridCandidates(m, std::nullopt, i_searchArea, [this](Player* obj)
+    {
+        if (i_check(obj))
+            Insert(obj);
+
+        return false;
+    });
 }
 
 template<class Check>
@@ -259,9 +256,13 @@ void Warhead::WorldObjectListSearcher<Check>::Visit(CreatureMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CREATURE))
         return;
 
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->GetSource()))
-            Insert(itr->GetSource());
+    VisitGridCandidates(m, std::nullopt, i_searchArea, [this](Creature* obj)
+    {
+        if (i_check(obj))
+            Insert(obj);
+
+        return false;
+    });
 }
 
 template<class Check>
@@ -270,9 +271,13 @@ void Warhead::WorldObjectListSearcher<Check>::Visit(CorpseMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CORPSE))
         return;
 
-    for (CorpseMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->GetSource()))
-            Insert(itr->GetSource());
+    VisitGridCandidates(m, std::nullopt, i_searchArea, [this](Corpse* obj)
+    {
+        if (i_check(obj))
+            Insert(obj);
+
+        return false;
+    });
 }
 
 template<class Check>
@@ -281,9 +286,13 @@ void Warhead::WorldObjectListSearcher<Check>::Visit(GameObjectMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_GAMEOBJECT))
         return;
 
-    for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->GetSource()))
-            Insert(itr->GetSource());
+    VisitGridCandidates(m, std::nullopt, i_searchArea, [this](GameObject* obj)
+    {
+        if (i_check(obj))
+            Insert(obj);
+
+        return false;
+    });
 }
 
 template<class Check>
@@ -292,9 +301,13 @@ void Warhead::WorldObjectListSearcher<Check>::Visit(DynamicObjectMapType& m)
     if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_DYNAMICOBJECT))
         return;
 
-    for (DynamicObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (i_check(itr->GetSource()))
-            Insert(itr->GetSource());
+    VisitGridCandidates(m, std::nullopt, i_searchArea, [this](DynamicObject* obj)
+    {
+        if (i_check(obj))
+            Insert(obj);
+
+        return false;
+    });
 }
 
 // Gameobject searchers
@@ -306,39 +319,38 @@ void Warhead::GameObjectSearcher<Check>::Visit(GameObjectMapType& m)
     if (i_object)
         return;
 
-    for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](GameObject* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!i_check(obj))
+            return false;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = obj;
+        return true;
+    });
 }
 
 template<class Check>
 void Warhead::GameObjectLastSearcher<Check>::Visit(GameObjectMapType& m)
 {
-    for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](GameObject* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (i_check(obj))
+            i_object = obj;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        return false;
+    });
 }
 
 template<class Check>
 void Warhead::GameObjectListSearcher<Check>::Visit(GameObjectMapType& m)
 {
-    for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->GetSource()))
-                Insert(itr->GetSource());
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](GameObject* obj)
+    {
+        if (i_check(obj))
+            Insert(obj);
+
+        return false;
+    });
 }
 
 // Unit searchers
@@ -350,17 +362,14 @@ void Warhead::UnitSearcher<Check>::Visit(CreatureMapType& m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Creature* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!i_check(obj))
+            return false;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = obj;
+        return true;
+    });
 }
 
 template<class Check>
@@ -370,61 +379,62 @@ void Warhead::UnitSearcher<Check>::Visit(PlayerMapType& m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Player* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!i_check(obj))
+            return false;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = obj;
+        return true;
+    });
 }
 
 template<class Check>
 void Warhead::UnitLastSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Creature* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (i_check(obj))
+            i_object = obj;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        return false;
+    });
 }
 
 template<class Check>
 void Warhead::UnitLastSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Player* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (i_check(obj))
+            i_object = obj;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        return false;
+    });
 }
 
 template<class Check>
 void Warhead::UnitListSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->GetSource()))
-                Insert(itr->GetSource());
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Player* obj)
+    {
+        if (i_check(obj))
+            Insert(obj);
+
+        return false;
+    });
 }
 
 template<class Check>
 void Warhead::UnitListSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->GetSource()))
-                Insert(itr->GetSource());
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Creature* obj)
+    {
+        if (i_check(obj))
+            Insert(obj);
+
+        return false;
+    });
 }
 
 // Creature searchers
@@ -436,48 +446,50 @@ void Warhead::CreatureSearcher<Check>::Visit(CreatureMapType& m)
     if (i_object)
         return;
 
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Creature* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!i_check(obj))
+            return false;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = obj;
+        return true;
+    });
 }
 
 template<class Check>
 void Warhead::CreatureLastSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Creature* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (i_check(obj))
+            i_object = obj;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        return false;
+    });
 }
 
 template<class Check>
 void Warhead::CreatureListSearcher<Check>::Visit(CreatureMapType& m)
 {
-    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->GetSource()))
-                Insert(itr->GetSource());
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Creature* obj)
+    {
+        if (i_check(obj))
+            Insert(obj);
+
+        return false;
+    });
 }
 
 template<class Check>
 void Warhead::PlayerListSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
-        if (itr->GetSource()->InSamePhase(i_phaseMask))
-            if (i_check(itr->GetSource()))
-                Insert(itr->GetSource());
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Player* obj)
+    {
+        if (i_check(obj))
+            Insert(obj);
+
+        return false;
+    });
 }
 
 template<class Check>
@@ -506,30 +518,26 @@ void Warhead::PlayerSearcher<Check>::Visit(PlayerMapType& m)
     if (i_object)
         return;
 
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Player* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (!i_check(obj))
+            return false;
 
-        if (i_check(itr->GetSource()))
-        {
-            i_object = itr->GetSource();
-            return;
-        }
-    }
+        i_object = obj;
+        return true;
+    });
 }
 
 template<class Check>
 void Warhead::PlayerLastSearcher<Check>::Visit(PlayerMapType& m)
 {
-    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+    VisitGridCandidates(m, i_phaseMask, i_searchArea, [this](Player* obj)
     {
-        if (!itr->GetSource()->InSamePhase(i_phaseMask))
-            continue;
+        if (i_check(obj))
+            i_object = obj;
 
-        if (i_check(itr->GetSource()))
-            i_object = itr->GetSource();
-    }
+        return false;
+    });
 }
 
 template<class Builder>
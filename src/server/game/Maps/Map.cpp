@@ -31,15 +31,18 @@
 #include "InstanceScript.h"
 #include "LFGMgr.h"
 #include "MapMgr.h"
+#include "MapUpdater.h"
 #include "Metric.h"
 #include "MiscPackets.h"
 #include "ObjectAccessor.h"
+#include "Pet.h"
 #include "ScriptMgr.h"
 #include "Transport.h"
 #include "VMapFactory.h"
 #include "VMapMgr2.h"
 #include "Vehicle.h"
 #include "Weather.h"
+#include <condition_variable>
 #include <utility>
 
 union u_map_magic
@@ -57,6 +60,49 @@ u_map_magic MapLiquidMagic  = { {'M', 'L', 'I', 'Q'} };
 static uint16 const holetab_h[4] = { 0x1111, 0x2222, 0x4444, 0x8888 };
 static uint16 const holetab_v[4] = { 0x000F, 0x00F0, 0x0F00, 0xF000 };
 
+namespace
+{
+    // Slot of the region worker running on this thread, -1 outside of a sharded map update
+    thread_local int32 _updateShardSlot = -1;
+
+    struct MapShardedUpdateContext
+    {
+        std::vector<std::vector<uint32>> Regions;        // interior cells of every region
+        std::vector<std::vector<ObjectGuid>> Deferred;   // objects handed back to the map thread, per region
+        std::atomic<std::size_t> NextRegion{};
+        std::atomic<int32> NextSlot{};
+        std::size_t FinishedRegions{};
+        std::mutex Lock;
+        std::condition_variable Condition;
+    };
+
+    void UpdateShardRegions(Map* map, MapShardedUpdateContext& context, uint32 diff)
+    {
+        for (std::size_t index = context.NextRegion++; index < context.Regions.size(); index = context.NextRegion++)
+        {
+            if (_updateShardSlot < 0)
+                _updateShardSlot = context.NextSlot++;
+
+            Warhead::ShardedObjectUpdater updater(diff, context.Deferred[index]);
+            TypeContainerVisitor<Warhead::ShardedObjectUpdater, GridTypeMapContainer> gridVisitor(updater);
+            TypeContainerVisitor<Warhead::ShardedObjectUpdater, WorldTypeMapContainer> worldVisitor(updater);
+
+            for (uint32 cellId : context.Regions[index])
+            {
+                Cell cell(CellCoord(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+                map->Visit(cell, gridVisitor);
+                map->Visit(cell, worldVisitor);
+            }
+
+            std::lock_guard<std::mutex> guard(context.Lock);
+            if (++context.FinishedRegions == context.Regions.size())
+                context.Condition.notify_one();
+        }
+
+        _updateShardSlot = -1;
+    }
+}
+
 ZoneDynamicInfo::ZoneDynamicInfo() :
     WeatherId(WEATHER_STATE_FINE) { }
 
@@ -429,6 +475,7 @@ void Map::EnsureGridCreated(const GridCoord& p)
     if (getNGrid(p.x_coord, p.y_coord)) // pussywizard
         return;
 
+    auto sharedGuard = AcquireSharedStateLock();
     std::lock_guard<std::mutex> guard(GridLock);
     EnsureGridCreated_i(p);
 }
@@ -472,6 +519,12 @@ bool Map::EnsureGridLoaded(const Cell& cell)
     ASSERT(grid);
     if (!isGridObjectDataLoaded(cell.GridX(), cell.GridY()))
     {
+        auto guard = AcquireSharedStateLock();
+
+        // check again after acquiring lock, another region worker could load it meanwhile
+        if (isGridObjectDataLoaded(cell.GridX(), cell.GridY()))
+            return false;
+
         LOG_DEBUG("maps", "Loading grid[{}, {}] for map {} instance {}", cell.GridX(), cell.GridY(), GetId(), _instanceId);
 
         setGridObjectDataLoaded(true, cell.GridX(), cell.GridY());
@@ -573,6 +626,8 @@ bool Map::AddToMap(T* obj, bool checkTransport)
         return false; //Should delete object
     }
 
+    auto guard = AcquireSharedStateLock();
+
     Cell cell(cellCoord);
     if (obj->isActiveObject())
         EnsureGridLoaded(cell);
@@ -683,6 +738,13 @@ void Map::VisitNearbyCellsOfPlayer(Player* player, TypeContainerVisitor<Warhead:
                 continue;
 
             markCellLarge(cell_id);
+
+            if (_collectShardCells)
+            {
+                _shardCellsLarge.push_back(cell_id);
+                continue;
+            }
+
             CellCoord pair(x, y);
             Cell cell(pair);
 
@@ -718,6 +780,21 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Warhead::Obj
                 continue;
 
             markCell(cell_id);
+
+            // sharded update visits collected cells after all players are updated
+            if (_collectShardCells)
+            {
+                _shardCells.push_back(cell_id);
+
+                if (!isCellMarkedLarge(cell_id))
+                {
+                    markCellLarge(cell_id);
+                    _shardCellsLarge.push_back(cell_id);
+                }
+
+                continue;
+            }
+
             CellCoord pair(x, y);
             Cell cell(pair);
             //cell.SetNoCreate(); // in mmaps this is missing
@@ -738,7 +815,11 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Warhead::Obj
 void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 {
     if (t_diff)
+    {
+        // session only ticks take a fraction of the time, the load is judged by full updates only
+        _dynamicVisibility.Update(GetEntry()->map_type, t_diff, _lastUpdateDuration);
         _dynamicTree.update(t_diff);
+    }
 
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefMgr.begin(); m_mapRefIter != m_mapRefMgr.end(); ++m_mapRefIter)
@@ -766,6 +847,9 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
             player->Update(s_diff);
         }
 
+        // player movement arrives with the session updates, its terrain status can't wait for the next full update
+        UpdateAllPositionDataInUpdateList();
+
         HandleDelayedVisibility();
         return;
     }
@@ -791,6 +875,9 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
     std::vector<Creature*> updateList;
     updateList.reserve(10);
 
+    // cells around players and active objects are only collected here, regions are updated below
+    _collectShardCells = CanUseShardedUpdate();
+
     // non-player active objects, increasing iterator in the loop in case of object removal
     for (_activeNonPlayersIter = _activeNonPlayers.begin(); _activeNonPlayersIter != _activeNonPlayers.end();)
     {
@@ -853,6 +940,12 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
         }
     }
 
+    if (_collectShardCells)
+    {
+        _collectShardCells = false;
+        UpdateCellsSharded(t_diff, grid_object_update, world_object_update, grid_large_object_update, world_large_object_update);
+    }
+
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();) // pussywizard: transports updated after VisitNearbyCellsOf, grids around are loaded, everything ok
     {
         MotionTransport* transport = *_transportsUpdateIter;
@@ -874,6 +967,8 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
         _scriptLock = false;
     }
 
+    UpdateAllPositionDataInUpdateList();
+
     MoveAllCreaturesInMoveList();
     MoveAllGameObjectsInMoveList();
     MoveAllDynamicObjectsInMoveList();
@@ -889,6 +984,28 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
     METRIC_VALUE("map_gameobjects", uint64(GetObjectsStore().Size<GameObject>()),
         METRIC_TAG("map_id", std::to_string(GetId())),
         METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    METRIC_VALUE("map_visibility_notify_delay", _dynamicVisibility.GetVisibilityNotifyDelay(),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    METRIC_VALUE("map_visibility_ai_notify_delay", _dynamicVisibility.GetAINotifyDelay(),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    METRIC_VALUE("map_visibility_move_distance", std::sqrt(_dynamicVisibility.GetReqMoveDistSq()),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    METRIC_VALUE("map_visibility_load", _dynamicVisibility.GetLoad(),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+}
+
+void Map::AddObjectToDelayedVisibility(Unit* unit)
+{
+    auto guard = AcquireSharedStateLock();
+    i_objectsForDelayedVisibility.insert(unit);
 }
 
 void Map::HandleDelayedVisibility()
@@ -902,6 +1019,187 @@ void Map::HandleDelayedVisibility()
     i_objectsForDelayedVisibility.clear();
 }
 
+/*static*/ int32 Map::GetUpdateShardSlot()
+{
+    return _updateShardSlot;
+}
+
+dtNavMeshQuery const* Map::GetNavMeshQuery()
+{
+    if (_updateShardSlot >= 0)
+        return std::size_t(_updateShardSlot) < _shardNavMeshQueries.size() ? _shardNavMeshQueries[_updateShardSlot] : nullptr;
+
+    dtNavMeshQuery const* query = _navMeshQuery.load(std::memory_order_acquire);
+    if (!query)
+    {
+        // none until the first nav mesh tile of the map is loaded
+        query = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshQuery(GetId(), GetInstanceId());
+        _navMeshQuery.store(query, std::memory_order_release);
+    }
+
+    return query;
+}
+
+/*static*/ bool Map::CanUpdateInShard(WorldObject const* obj)
+{
+    // passengers are moved by their transport, which can cross any region
+    if (obj->GetTransport())
+        return false;
+
+    switch (obj->GetTypeId())
+    {
+        case TYPEID_UNIT:
+        {
+            // combat, respawn, owners, formations and vehicles reach objects far outside of the creature cell
+            Creature const* creature = obj->ToCreature();
+            return creature->IsAlive() && !creature->IsInCombat() && !creature->IsSummon() && !creature->GetCharmerOrOwnerGUID() &&
+                !creature->GetFormation() && !creature->GetVehicleKit() && !creature->GetVehicle() && creature->m_Controlled.empty();
+        }
+        case TYPEID_GAMEOBJECT:
+        {
+            // respawn may spawn another member of the pool anywhere on the map
+            GameObject const* go = obj->ToGameObject();
+            return go->isSpawned() && !go->GetOwnerGUID() && !go->IsTransport();
+        }
+        default:
+            return false;
+    }
+}
+
+bool Map::CanUseShardedUpdate() const
+{
+    if (Instanceable() || !CONF_GET_BOOL("MapUpdate.Sharding.Enable"))
+        return false;
+
+    // the map thread is a worker itself, sharding makes sense with at least one more thread
+    MapUpdater* mapUpdater = sMapMgr->GetMapUpdater();
+    if (!mapUpdater->IsActive() || mapUpdater->GetThreadsCount() < 2)
+        return false;
+
+    return m_mapRefMgr.getSize() >= CONF_GET_UINT("MapUpdate.Sharding.MinPlayers");
+}
+
+void Map::UpdateCellsSharded(uint32 t_diff, TypeContainerVisitor<Warhead::ObjectUpdater, GridTypeMapContainer>& gridVisitor,
+                             TypeContainerVisitor<Warhead::ObjectUpdater, WorldTypeMapContainer>& worldVisitor,
+                             TypeContainerVisitor<Warhead::ObjectUpdater, GridTypeMapContainer>& largeGridVisitor,
+                             TypeContainerVisitor<Warhead::ObjectUpdater, WorldTypeMapContainer>& largeWorldVisitor)
+{
+    uint32 const regionCells = std::max<uint32>(CONF_GET_UINT("MapUpdate.Sharding.RegionSize"), 1) * MAX_NUMBER_OF_CELLS;
+    uint32 const regionsPerRow = (TOTAL_NUMBER_OF_CELLS_PER_MAP + regionCells - 1) / regionCells;
+
+    // objects closer than this to a region edge may reach into the neighbour region (relocation, visibility, spells),
+    // such cells are handed off to the map thread and updated after all regions are done
+    uint32 const borderCells = std::max<uint32>(CONF_GET_UINT("MapUpdate.Sharding.BorderCells"), uint32(std::ceil(GetVisibilityRange() / SIZE_OF_GRID_CELL)));
+
+    auto context = std::make_shared<MapShardedUpdateContext>();
+    std::unordered_map<uint32, std::size_t> regionIndexes;
+    std::vector<uint32> borderCellIds;
+
+    for (uint32 cellId : _shardCells)
+    {
+        uint32 const x = cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP;
+        uint32 const y = cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP;
+
+        // grid loading adds objects to several cells at once, never let it happen inside of a region worker
+        EnsureGridLoaded(Cell(CellCoord(x, y)));
+
+        uint32 const localX = x % regionCells;
+        uint32 const localY = y % regionCells;
+
+        if (localX < borderCells || localY < borderCells || localX + borderCells >= regionCells || localY + borderCells >= regionCells)
+        {
+            borderCellIds.push_back(cellId);
+            continue;
+        }
+
+        auto [itr, inserted] = regionIndexes.emplace((y / regionCells) * regionsPerRow + x / regionCells, context->Regions.size());
+        if (inserted)
+            context->Regions.emplace_back();
+
+        context->Regions[itr->second].push_back(cellId);
+    }
+
+    if (!context->Regions.empty())
+    {
+        context->Deferred.resize(context->Regions.size());
+
+        MapUpdater* mapUpdater = sMapMgr->GetMapUpdater();
+        std::size_t const helpers = std::min(context->Regions.size(), mapUpdater->GetThreadsCount()) - 1;
+
+        // the workers only read the queries of their slots, missing ones are created here
+        _shardNavMeshQueries.resize(std::max(_shardNavMeshQueries.size(), helpers + 1), nullptr);
+        for (std::size_t slot = 0; slot < _shardNavMeshQueries.size(); ++slot)
+            if (!_shardNavMeshQueries[slot])
+                _shardNavMeshQueries[slot] = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshQuery(GetId(), MMAP::SHARDED_UPDATE_QUERY_ID + uint32(slot));
+
+        _shardedUpdateActive = true;
+
+        for (std::size_t i = 0; i < helpers; ++i)
+            mapUpdater->ScheduleTask([this, context, t_diff]() { UpdateShardRegions(this, *context, t_diff); });
+
+        // the map thread takes regions too, helpers can stay queued behind other maps for the whole update
+        UpdateShardRegions(this, *context, t_diff);
+
+        {
+            std::unique_lock<std::mutex> lock(context->Lock);
+            context->Condition.wait(lock, [&context]() { return context->FinishedRegions == context->Regions.size(); });
+        }
+
+        _shardedUpdateActive = false;
+    }
+
+    for (uint32 cellId : borderCellIds)
+    {
+        Cell cell(CellCoord(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+        Visit(cell, gridVisitor);
+        Visit(cell, worldVisitor);
+    }
+
+    for (auto const& deferred : context->Deferred)
+        for (ObjectGuid const& guid : deferred)
+            if (WorldObject* obj = GetShardDeferredObject(guid))
+                if (obj->IsInWorld())
+                    obj->Update(t_diff);
+
+    for (uint32 cellId : _shardCellsLarge)
+    {
+        Cell cell(CellCoord(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+        Visit(cell, largeGridVisitor);
+        Visit(cell, largeWorldVisitor);
+    }
+
+    METRIC_VALUE("map_sharded_regions", uint64(context->Regions.size()),
+        METRIC_TAG("map_id", std::to_string(GetId())));
+
+    METRIC_VALUE("map_sharded_border_cells", uint64(borderCellIds.size()),
+        METRIC_TAG("map_id", std::to_string(GetId())));
+
+    _shardCells.clear();
+    _shardCellsLarge.clear();
+}
+
+WorldObject* Map::GetShardDeferredObject(ObjectGuid const guid)
+{
+    switch (guid.GetHigh())
+    {
+        case HighGuid::Unit:
+        case HighGuid::Vehicle:
+            return GetCreature(guid);
+        case HighGuid::Pet:
+            return GetPet(guid);
+        case HighGuid::GameObject:
+        case HighGuid::Transport:
+        case HighGuid::Mo_Transport:
+            return GetGameObject(guid);
+        case HighGuid::DynamicObject:
+            return GetDynamicObject(guid);
+        case HighGuid::Corpse:
+            return GetCorpse(guid);
+        default:
+            return nullptr;
+    }
+}
+
 struct ResetNotifier
 {
     template<class T>
@@ -948,6 +1246,8 @@ void Map::AfterPlayerUnlinkFromMap()
 template<class T>
 void Map::RemoveFromMap(T* obj, bool remove)
 {
+    auto guard = AcquireSharedStateLock();
+
     bool inWorld = obj->IsInWorld() && obj->GetTypeId() >= TYPEID_UNIT && obj->GetTypeId() <= TYPEID_GAMEOBJECT;
     obj->RemoveFromWorld();
 
@@ -1031,7 +1331,7 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float o)
     if (player->IsVehicle())
         player->GetVehicleKit()->RelocatePassengers();
 
-    player->UpdatePositionData();
+    AddToPositionDataUpdateList(player);
     player->UpdateObjectVisibility(false);
 }
 
@@ -1055,7 +1355,7 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
     if (creature->IsVehicle())
         creature->GetVehicleKit()->RelocatePassengers();
 
-    creature->UpdatePositionData();
+    AddToPositionDataUpdateList(creature);
     creature->UpdateObjectVisibility(false);
 }
 
@@ -1102,6 +1402,8 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
 
 void Map::AddCreatureToMoveList(Creature* c)
 {
+    auto guard = AcquireSharedStateLock();
+
     if (c->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _creaturesToMove.push_back(c);
 
@@ -1116,6 +1418,8 @@ void Map::RemoveCreatureFromMoveList(Creature* c)
 
 void Map::AddGameObjectToMoveList(GameObject* go)
 {
+    auto guard = AcquireSharedStateLock();
+
     if (go->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _gameObjectsToMove.push_back(go);
 
@@ -1130,6 +1434,8 @@ void Map::RemoveGameObjectFromMoveList(GameObject* go)
 
 void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj)
 {
+    auto guard = AcquireSharedStateLock();
+
     if (dynObj->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _dynamicObjectsToMove.push_back(dynObj);
     dynObj->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
@@ -1141,8 +1447,64 @@ void Map::RemoveDynamicObjectFromMoveList(DynamicObject* dynObj)
         dynObj->_moveState = MAP_OBJECT_CELL_MOVE_INACTIVE;
 }
 
+void Map::AddToPositionDataUpdateList(Unit* unit)
+{
+    // several relocations of the same unit within one update only need the terrain lookup once
+    bool queued = unit->IsPositionDataUpdatePending();
+    unit->SetPositionDataUpdate();
+    if (queued || !unit->IsPositionDataUpdatePending())
+        return;
+
+    auto guard = AcquireSharedStateLock();
+    _unitsToUpdatePositionData.push_back(unit->GetGUID());
+}
+
+void Map::UpdateAllPositionDataInUpdateList()
+{
+    std::vector<ObjectGuid> units;
+    {
+        auto guard = AcquireSharedStateLock();
+        units.swap(_unitsToUpdatePositionData);
+    }
+
+    // units may have left the map or been deleted since they were queued
+    for (ObjectGuid const& guid : units)
+    {
+        Unit* unit = nullptr;
+        if (guid.IsPlayer())
+            unit = ObjectAccessor::GetPlayer(this, guid);
+        else if (guid.IsPet())
+            unit = GetPet(guid);
+        else
+            unit = GetCreature(guid);
+
+        if (unit && unit->IsInWorld() && unit->IsPositionDataUpdatePending())
+            unit->UpdatePositionData();
+    }
+}
+
+namespace
+{
+    // cell moves are applied grouped by destination cell
+    template<class T>
+    void SortMoveListByCell(std::vector<T*>& moveList)
+    {
+        std::vector<std::pair<uint32, T*>> keyed;
+        keyed.reserve(moveList.size());
+        for (T* obj : moveList)
+            keyed.emplace_back(Warhead::ComputeCellCoord(obj->GetPositionX(), obj->GetPositionY()).GetId(), obj);
+
+        std::stable_sort(keyed.begin(), keyed.end(), [](auto const& left, auto const& right) { return left.first < right.first; });
+
+        for (std::size_t i = 0; i < keyed.size(); ++i)
+            moveList[i] = keyed[i].second;
+    }
+}
+
 void Map::MoveAllCreaturesInMoveList()
 {
+    SortMoveListByCell(_creaturesToMove);
+
     for (auto c : _creaturesToMove)
     {
         if (c->FindMap() != this)
@@ -1174,6 +1536,8 @@ void Map::MoveAllCreaturesInMoveList()
 
 void Map::MoveAllGameObjectsInMoveList()
 {
+    SortMoveListByCell(_gameObjectsToMove);
+
     for (auto go : _gameObjectsToMove)
     {
         if (go->FindMap() != this)
@@ -1205,6 +1569,8 @@ void Map::MoveAllGameObjectsInMoveList()
 
 void Map::MoveAllDynamicObjectsInMoveList()
 {
+    SortMoveListByCell(_dynamicObjectsToMove);
+
     for (auto dynObj : _dynamicObjectsToMove)
     {
         if (dynObj->FindMap() != this)
@@ -1298,6 +1664,7 @@ void Map::UnloadAll()
     // clear all delayed moves, useless anyway do this moves before map unload.
     _creaturesToMove.clear();
     _gameObjectsToMove.clear();
+    _unitsToUpdatePositionData.clear();
 
     for (GridRefMgr<NGridType>::iterator i = GridRefMgr<NGridType>::begin(); i != GridRefMgr<NGridType>::end();)
     {
@@ -2681,6 +3048,8 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 {
     ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
+    auto guard = AcquireSharedStateLock();
+
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
 
     i_objectsToRemove.insert(obj);
@@ -2695,6 +3064,8 @@ void Map::AddObjectToSwitchList(WorldObject* obj, bool on)
     if (obj->GetTypeId() != TYPEID_UNIT && obj->GetTypeId() != TYPEID_GAMEOBJECT)
         return;
 
+    auto guard = AcquireSharedStateLock();
+
     auto itr = i_objectsToSwitch.find(obj);
     if (itr == i_objectsToSwitch.end())
         i_objectsToSwitch.insert(itr, std::make_pair(obj, on));
@@ -2782,8 +3153,9 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    SharedWorldPacket sharedData(*data);
     for (MapRefMgr::const_iterator itr = m_mapRefMgr.begin(); itr != m_mapRefMgr.end(); ++itr)
-        itr->GetSource()->GetSession()->SendPacket(data);
+        itr->GetSource()->GetSession()->SendPacket(sharedData);
 }
 
 template<class T>
@@ -3401,21 +3773,25 @@ void BattlegroundMap::RemoveAllPlayers()
 
 Corpse* Map::GetCorpse(ObjectGuid const guid)
 {
+    auto guard = AcquireSharedStateLock();
     return _objectsStore.Find<Corpse>(guid);
 }
 
 Creature* Map::GetCreature(ObjectGuid const guid)
 {
+    auto guard = AcquireSharedStateLock();
     return _objectsStore.Find<Creature>(guid);
 }
 
 GameObject* Map::GetGameObject(ObjectGuid const guid)
 {
+    auto guard = AcquireSharedStateLock();
     return _objectsStore.Find<GameObject>(guid);
 }
 
 Pet* Map::GetPet(ObjectGuid const guid)
 {
+    auto guard = AcquireSharedStateLock();
     return _objectsStore.Find<Pet>(guid);
 }
 
@@ -3430,6 +3806,7 @@ Transport* Map::GetTransport(ObjectGuid guid)
 
 DynamicObject* Map::GetDynamicObject(ObjectGuid guid)
 {
+    auto guard = AcquireSharedStateLock();
     return _objectsStore.Find<DynamicObject>(guid);
 }
 
@@ -3452,6 +3829,7 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
+    auto guard = AcquireSharedStateLock();
     _creatureRespawnTimes[spawnId] = respawnTime;
 
     CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CREATURE_RESPAWN);
@@ -3464,6 +3842,7 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
 
 void Map::RemoveCreatureRespawnTime(ObjectGuid::LowType spawnId)
 {
+    auto guard = AcquireSharedStateLock();
     _creatureRespawnTimes.erase(spawnId);
 
     CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN);
@@ -3486,6 +3865,7 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
+    auto guard = AcquireSharedStateLock();
     _goRespawnTimes[spawnId] = respawnTime;
 
     CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_GO_RESPAWN);
@@ -3498,6 +3878,7 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
 
 void Map::RemoveGORespawnTime(ObjectGuid::LowType spawnId)
 {
+    auto guard = AcquireSharedStateLock();
     _goRespawnTimes.erase(spawnId);
 
     CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN);
@@ -22,11 +22,13 @@
 #include "DBCStructure.h"
 #include "DataMap.h"
 #include "DynamicTree.h"
+#include "DynamicVisibility.h"
 #include "GridDefines.h"
 #include "GridRefMgr.h"
 #include "MapRefMgr.h"
 #include "ObjectDefines.h"
 #include "ObjectGuid.h"
+#include <atomic>
 #include <bitset>
 #include <list>
 #include <memory>
@@ -54,6 +56,7 @@ class MotionTransport;
 class PathGenerator;
 class GameObjectModel;
 class MapEntry;
+class dtNavMeshQuery;
 
 struct ScriptInfo;
 struct ScriptAction;
@@ -404,8 +407,26 @@ public:
 
     // pussywizard:
     std::unordered_set<Unit*> i_objectsForDelayedVisibility;
+    void AddObjectToDelayedVisibility(Unit* unit);
     void HandleDelayedVisibility();
 
+    // Sharded update: grid regions of a continent updated in parallel on the map updater threads
+    [[nodiscard]] bool IsInShardedUpdate() const { return _shardedUpdateActive; }
+    [[nodiscard]] std::unique_lock<std::recursive_mutex> AcquireSharedStateLock()
+    {
+        // map-wide containers are only shared between threads while the region workers run
+        if (!_shardedUpdateActive)
+            return {};
+
+        return std::unique_lock<std::recursive_mutex>(_shardedUpdateLock);
+    }
+
+    static bool CanUpdateInShard(WorldObject const* obj);
+    static int32 GetUpdateShardSlot();
+
+    // Nav mesh query of the thread updating the map, region workers of a sharded update have their own
+    [[nodiscard]] dtNavMeshQuery const* GetNavMeshQuery();
+
     // some calls like isInWater should not use vmaps due to processor power
     // can return INVALID_HEIGHT if under z+2 z coord not found height
     [[nodiscard]] float GetHeight(float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
@@ -473,8 +494,17 @@ public:
     [[nodiscard]] bool HavePlayers() const { return !m_mapRefMgr.IsEmpty(); }
     [[nodiscard]] uint32 GetPlayersCountExceptGMs() const;
 
-    void AddWorldObject(WorldObject* obj) { i_worldObjects.insert(obj); }
-    void RemoveWorldObject(WorldObject* obj) { i_worldObjects.erase(obj); }
+    void AddWorldObject(WorldObject* obj)
+    {
+        auto guard = AcquireSharedStateLock();
+        i_worldObjects.insert(obj);
+    }
+
+    void RemoveWorldObject(WorldObject* obj)
+    {
+        auto guard = AcquireSharedStateLock();
+        i_worldObjects.erase(obj);
+    }
 
     void SendToPlayers(WorldPacket const* data) const;
 
@@ -632,16 +662,19 @@ public:
     inline ObjectGuid::LowType GenerateLowGuid()
     {
         static_assert(ObjectGuidTraits<high>::MapSpecific, "Only map specific guid can be generated in Map context");
+        auto guard = AcquireSharedStateLock();
         return GetGuidSequenceGenerator<high>().Generate();
     }
 
     void AddUpdateObject(Object* obj)
     {
+        auto guard = AcquireSharedStateLock();
         _updateObjects.insert(obj);
     }
 
     void RemoveUpdateObject(Object* obj)
     {
+        auto guard = AcquireSharedStateLock();
         _updateObjects.erase(obj);
     }
 
@@ -650,6 +683,13 @@ public:
         return _activeNonPlayers.size();
     }
 
+    // Duration of the last full (t_diff != 0) or session only Map::Update, used by the map updater to start the slowest maps first
+    [[nodiscard]] Microseconds GetLastUpdateDuration(bool full) const { return full ? _lastUpdateDuration : _lastSessionUpdateDuration; }
+    void SetLastUpdateDuration(bool full, Microseconds duration) { (full ? _lastUpdateDuration : _lastSessionUpdateDuration) = duration; }
+
+    // visibility notify delays and relocation distance currently used for objects on this map
+    [[nodiscard]] DynamicVisibilityController const& GetDynamicVisibility() const { return _dynamicVisibility; }
+
     virtual std::string GetDebugInfo() const;
 
 private:
@@ -674,6 +714,11 @@ private:
     std::vector<GameObject*> _gameObjectsToMove;
     std::vector<DynamicObject*> _dynamicObjectsToMove;
 
+    // units relocated during this update, their terrain data is refreshed once at the end of it (or earlier on access)
+    void AddToPositionDataUpdateList(Unit* unit);
+    void UpdateAllPositionDataInUpdateList();
+    std::vector<ObjectGuid> _unitsToUpdatePositionData;
+
     [[nodiscard]] bool IsGridLoaded(const GridCoord&) const;
     void EnsureGridCreated_i(const GridCoord&);
 
@@ -693,6 +738,13 @@ private:
     void ScriptsProcess();
     void SendObjectUpdates();
 
+    [[nodiscard]] bool CanUseShardedUpdate() const;
+    void UpdateCellsSharded(uint32 t_diff, TypeContainerVisitor<Warhead::ObjectUpdater, GridTypeMapContainer>& gridVisitor,
+                            TypeContainerVisitor<Warhead::ObjectUpdater, WorldTypeMapContainer>& worldVisitor,
+                            TypeContainerVisitor<Warhead::ObjectUpdater, GridTypeMapContainer>& largeGridVisitor,
+                            TypeContainerVisitor<Warhead::ObjectUpdater, WorldTypeMapContainer>& largeWorldVisitor);
+    WorldObject* GetShardDeferredObject(ObjectGuid const guid);
+
 protected:
     std::mutex Lock;
     std::mutex GridLock;
@@ -737,6 +789,16 @@ private:
     std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells_large;
 
     bool _scriptLock{};
+
+    // Sharded update state, cells are collected by VisitNearbyCellsOf instead of being visited in place
+    std::atomic<bool> _shardedUpdateActive{};
+    std::recursive_mutex _shardedUpdateLock;
+    bool _collectShardCells{};
+    std::vector<uint32> _shardCells;
+    std::vector<uint32> _shardCellsLarge;
+    std::atomic<dtNavMeshQuery const*> _navMeshQuery{};
+    std::vector<dtNavMeshQuery const*> _shardNavMeshQueries;   // by region worker slot, only written before the workers start
+
     std::unordered_set<WorldObject*> i_objectsToRemove;
     std::map<WorldObject*, bool> i_objectsToSwitch;
     std::unordered_set<WorldObject*> i_worldObjects;
@@ -753,11 +815,14 @@ private:
 
     void AddToActiveHelper(WorldObject* obj)
     {
+        auto guard = AcquireSharedStateLock();
         _activeNonPlayers.insert(obj);
     }
 
     void RemoveFromActiveHelper(WorldObject* obj)
     {
+        auto guard = AcquireSharedStateLock();
+
         // Map::Update for active object in proccess
         if (_activeNonPlayersIter != _activeNonPlayers.end())
         {
@@ -797,6 +862,11 @@ private:
     std::unordered_set<Corpse*> _corpseBones;
 
     std::unordered_set<Object*> _updateObjects;
+
+    Microseconds _lastUpdateDuration{};
+    Microseconds _lastSessionUpdateDuration{};
+
+    DynamicVisibilityController _dynamicVisibility;
 };
 
 enum InstanceResetMethod
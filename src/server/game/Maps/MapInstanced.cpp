@@ -70,7 +70,9 @@ void MapInstanced::Update(uint32 t, uint32 s_diff, bool /*thread*/)
             continue;
         }
 
+        TimePoint start = std::chrono::steady_clock::now();
         map->Update(t, s_diff);
+        map->SetLastUpdateDuration(t != 0, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start));
     }
 
     // Erase maps
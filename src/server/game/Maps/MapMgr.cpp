@@ -61,11 +61,14 @@ void MapMgr::Initialize()
     // Init updater
     _updater = std::make_unique<MapUpdater>();
 
+    auto scheduler{ CONF_GET_INT("MapUpdate.Scheduler") == 1 ? MapUpdaterScheduler::WorkStealing : MapUpdaterScheduler::Queue };
+
     // Start mtmaps if needed
     if (threadsCount)
-        _updater->InitThreads(threadsCount);
+        _updater->InitThreads(threadsCount, scheduler);
 
-    LOG_INFO("server.loading", ">> Added {} threads for map update in {}", threadsCount, sw);
+    LOG_INFO("server.loading", ">> Added {} threads for map update ({} scheduler) in {}", threadsCount,
+        scheduler == MapUpdaterScheduler::WorkStealing ? "work stealing" : "queue", sw);
     LOG_INFO("server.loading", "");
 }
 
@@ -275,7 +278,7 @@ MapEnterState MapMgr::PlayerCannotEnter(uint32 mapid, Player* player, bool login
     return player->Satisfy(sObjectMgr->GetAccessRequirement(mapid, targetDifficulty), mapid, true) ? CAN_ENTER : CANNOT_ENTER_UNSPECIFIED_REASON;
 }
 
-void MapMgr::Update(uint32 diff)
+void MapMgr::Update(uint32 diff, std::function<void()> const& concurrentWork /*= nullptr*/)
 {
     for (auto& timer : _timer)
         timer.Update(diff);
@@ -301,7 +304,20 @@ void MapMgr::Update(uint32 diff)
         if (_updater->IsActive())
             _updater->ScheduleUpdate(*map, _diff, diff);
         else
+        {
+            TimePoint start = std::chrono::steady_clock::now();
             map->Update(_diff, diff);
+            map->SetLastUpdateDuration(_diff != 0, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start));
+        }
+    }
+
+    // world thread would only wait for the updater here, let it do independent work meanwhile
+    if (concurrentWork)
+    {
+        if (_updater->IsActive())
+            _updater->StartScheduled();
+
+        concurrentWork();
     }
 
     if (_updater->IsActive())
@@ -57,7 +57,7 @@ public:
     void GetZoneAndAreaId(uint32 phaseMask, uint32& zoneid, uint32& areaid, uint32 mapid, float x, float y, float z);
 
     void Initialize();
-    void Update(uint32);
+    void Update(uint32 diff, std::function<void()> const& concurrentWork = nullptr);
 
     void SetMapUpdateInterval(uint32 t);
 
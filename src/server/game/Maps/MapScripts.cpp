@@ -43,6 +43,8 @@ void Map::ScriptsStart(ScriptMapMap const& scripts, uint32 id, Object* source, O
     ObjectGuid targetGUID = target ? target->GetGUID() : ObjectGuid::Empty;
     ObjectGuid ownerGUID = (source && source->GetTypeId() == TYPEID_ITEM) ? ((Item*)source)->GetOwnerGUID() : ObjectGuid::Empty;
 
+    auto guard = AcquireSharedStateLock();
+
     ///- Schedule script execution for all scripts in the script map
     ScriptMap const* s2 = &(s->second);
     bool immedScript = false;
@@ -61,7 +63,8 @@ void Map::ScriptsStart(ScriptMapMap const& scripts, uint32 id, Object* source, O
         sMapMgr->IncreaseScheduledScriptsCount();
     }
     ///- If one of the effects should be immediate, launch the script execution
-    if (/*start &&*/ immedScript && !_scriptLock)
+    ///- Region workers of a sharded update leave it to the map thread, scripts may target any object of the map
+    if (/*start &&*/ immedScript && !_scriptLock && !IsInShardedUpdate())
     {
         _scriptLock = true;
         ScriptsProcess();
@@ -84,12 +87,14 @@ void Map::ScriptCommandStart(ScriptInfo const& script, uint32 delay, Object* sou
     sa.ownerGUID = ownerGUID;
 
     sa.script = &script;
+
+    auto guard = AcquireSharedStateLock();
     m_scriptSchedule.emplace(time_t(GameTime::GetGameTime().count() + delay), sa);
 
     sMapMgr->IncreaseScheduledScriptsCount();
 
     ///- If effects should be immediate, launch the script execution
-    if (delay == 0 && !_scriptLock)
+    if (delay == 0 && !_scriptLock && !IsInShardedUpdate())
     {
         _scriptLock = true;
         ScriptsProcess();
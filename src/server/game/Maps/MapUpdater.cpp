@@ -23,6 +23,18 @@
 #include "LFGMgr.h"
 #include "Map.h"
 #include "Metric.h"
+#include <algorithm>
+
+namespace
+{
+    // Index of the updater thread, used by work stealing to push nested tasks to own deque
+    thread_local std::ptrdiff_t _workerIndex = -1;
+
+    int64 GetElapsedNs(TimePoint start)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+}
 
 class UpdateRequest
 {
@@ -31,6 +43,9 @@ public:
     virtual ~UpdateRequest() = default;
 
     virtual void UpdateMap() = 0;
+
+    // Expected duration of the request, most expensive requests are started first
+    virtual Microseconds GetCost() const { return Microseconds::zero(); }
 };
 
 class MapUpdateRequest : public UpdateRequest
@@ -42,10 +57,17 @@ public:
     void UpdateMap() override
     {
         METRIC_TIMER("map_update_time_diff", METRIC_TAG("map_id", std::to_string(_map.GetId())));
+
+        TimePoint start = std::chrono::steady_clock::now();
         _map.Update(_mapDiff, _sDiff);
+        _map.SetLastUpdateDuration(_mapDiff != 0, std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start));
+
         _updater.FinishUpdate();
     }
 
+    // session only updates cost a fraction of a full one, each is measured on its own
+    Microseconds GetCost() const override { return _map.GetLastUpdateDuration(_mapDiff != 0); }
+
 private:
     Map& _map;
     MapUpdater& _updater;
@@ -64,17 +86,46 @@ public:
         _updater.FinishUpdate();
     }
 
+    // pussywizard: lfg compatibles update should be processed from the very beginning
+    Microseconds GetCost() const override { return Microseconds::max(); }
+
 private:
     MapUpdater& _updater;
     uint32 _diff;
 };
 
-void MapUpdater::InitThreads(std::size_t num_threads)
+class TaskUpdateRequest : public UpdateRequest
 {
+public:
+    TaskUpdateRequest(MapUpdater& u, std::function<void()>&& task) : _updater(u), _task(std::move(task)) { }
+
+    void UpdateMap() override
+    {
+        _task();
+        _updater.FinishUpdate();
+    }
+
+private:
+    MapUpdater& _updater;
+    std::function<void()> _task;
+};
+
+void MapUpdater::InitThreads(std::size_t num_threads, MapUpdaterScheduler scheduler /*= MapUpdaterScheduler::Queue*/)
+{
+    _scheduler = scheduler;
     _workerThreads.reserve(num_threads);
+    _workerData.reserve(num_threads);
+
+    for (std::size_t i = 0; i < num_threads; ++i)
+        _workerData.emplace_back(std::make_unique<WorkerData>());
 
     for (std::size_t i = 0; i < num_threads; ++i)
-        _workerThreads.emplace_back(&MapUpdater::InitializeThread, this);
+    {
+        if (_scheduler == MapUpdaterScheduler::WorkStealing)
+            _workerThreads.emplace_back(&MapUpdater::WorkStealingThread, this, i);
+        else
+            _workerThreads.emplace_back(&MapUpdater::InitializeThread, this, i);
+    }
 }
 
 void MapUpdater::Stop()
@@ -84,33 +135,72 @@ void MapUpdater::Stop()
     WaitThreads();
     _queue.Cancel();
 
+    {
+        std::lock_guard<std::mutex> guard(_wakeLock);
+        _wakeCondition.notify_all();
+    }
+
     for (auto& thread : _workerThreads)
         if (thread.joinable())
             thread.join();
 }
 
+void MapUpdater::StartScheduled()
+{
+    // queue scheduler hands requests out as soon as they are scheduled
+    if (_scheduler == MapUpdaterScheduler::WorkStealing)
+        DispatchScheduled();
+}
+
 void MapUpdater::WaitThreads()
 {
+    if (_scheduler == MapUpdaterScheduler::WorkStealing)
+        DispatchScheduled();
+
     std::unique_lock<std::mutex> guard(_lock);
 
     while (pending_requests)
         _condition.wait(guard);
 
     guard.unlock();
+
+    LogWorkerMetrics();
 }
 
 void MapUpdater::ScheduleUpdate(Map& map, uint32 diff, uint32 s_diff)
 {
     std::lock_guard<std::mutex> guard(_lock);
     ++pending_requests;
-    _queue.Push(new MapUpdateRequest(map, *this, diff, s_diff));
+
+    if (_scheduler == MapUpdaterScheduler::WorkStealing)
+        _scheduledRequests.emplace_back(new MapUpdateRequest(map, *this, diff, s_diff));
+    else
+        _queue.Push(new MapUpdateRequest(map, *this, diff, s_diff));
 }
 
 void MapUpdater::ScheduleLfgUpdate(uint32 diff)
 {
     std::lock_guard<std::mutex> guard(_lock);
     ++pending_requests;
-    _queue.Push(new LFGUpdateRequest(*this, diff));
+
+    if (_scheduler == MapUpdaterScheduler::WorkStealing)
+        _scheduledRequests.emplace_back(new LFGUpdateRequest(*this, diff));
+    else
+        _queue.Push(new LFGUpdateRequest(*this, diff));
+}
+
+void MapUpdater::ScheduleTask(std::function<void()>&& task)
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        ++pending_requests;
+    }
+
+    // tasks are scheduled from inside of running requests, they can't wait for the next dispatch
+    if (_scheduler == MapUpdaterScheduler::WorkStealing)
+        Push(new TaskUpdateRequest(*this, std::move(task)));
+    else
+        _queue.Push(new TaskUpdateRequest(*this, std::move(task)));
 }
 
 bool MapUpdater::IsActive()
@@ -125,21 +215,170 @@ void MapUpdater::FinishUpdate()
     _condition.notify_all();
 }
 
-void MapUpdater::InitializeThread()
+void MapUpdater::Push(UpdateRequest* request)
+{
+    // own deque for updater threads, so the request is picked up right after the current one unless stolen earlier
+    std::size_t index = _workerIndex >= 0 ? std::size_t(_workerIndex) : _nextWorker++ % _workerData.size();
+
+    // counted before it can be taken, a thief decrements only after finding it
+    ++_queuedRequests;
+
+    {
+        std::lock_guard<std::mutex> guard(_workerData[index]->Lock);
+        _workerData[index]->Requests.push_back(request);
+    }
+
+    std::lock_guard<std::mutex> guard(_wakeLock);
+    _wakeCondition.notify_all();
+}
+
+void MapUpdater::DispatchScheduled()
+{
+    std::vector<UpdateRequest*> requests;
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        requests.swap(_scheduledRequests);
+    }
+
+    if (requests.empty())
+        return;
+
+    // longest processing time first: slowest maps of the previous tick start first,
+    // each one goes to the thread with the lowest expected load
+    std::stable_sort(requests.begin(), requests.end(), [](UpdateRequest const* left, UpdateRequest const* right)
+    {
+        return left->GetCost() > right->GetCost();
+    });
+
+    std::vector<Microseconds> loads(_workerData.size(), Microseconds::zero());
+
+    _queuedRequests += requests.size();
+
+    for (UpdateRequest* request : requests)
+    {
+        std::size_t index = std::distance(loads.begin(), std::min_element(loads.begin(), loads.end()));
+
+        {
+            std::lock_guard<std::mutex> guard(_workerData[index]->Lock);
+            _workerData[index]->Requests.push_back(request);
+        }
+
+        Microseconds cost = request->GetCost();
+        loads[index] += cost == Microseconds::max() ? Microseconds(1000) : std::max(cost, Microseconds(1));
+    }
+
+    std::lock_guard<std::mutex> guard(_wakeLock);
+    _wakeCondition.notify_all();
+}
+
+UpdateRequest* MapUpdater::PopOrSteal(std::size_t index)
+{
+    if (!_queuedRequests)
+        return nullptr;
+
+    for (std::size_t i = 0; i < _workerData.size(); ++i)
+    {
+        WorkerData& worker = *_workerData[(index + i) % _workerData.size()];
+        std::lock_guard<std::mutex> guard(worker.Lock);
+
+        if (worker.Requests.empty())
+            continue;
+
+        UpdateRequest* request;
+
+        // own deque is processed from the most expensive request, others are robbed of their cheapest ones
+        if (!i)
+        {
+            request = worker.Requests.front();
+            worker.Requests.pop_front();
+        }
+        else
+        {
+            request = worker.Requests.back();
+            worker.Requests.pop_back();
+        }
+
+        --_queuedRequests;
+        return request;
+    }
+
+    return nullptr;
+}
+
+void MapUpdater::LogWorkerMetrics()
+{
+    if (!sMetric->IsEnabled())
+        return;
+
+    for (std::size_t i = 0; i < _workerData.size(); ++i)
+    {
+        METRIC_VALUE("map_updater_worker_busy", std::chrono::nanoseconds(_workerData[i]->BusyTime.exchange(0)),
+            METRIC_TAG("worker", std::to_string(i)));
+
+        METRIC_VALUE("map_updater_worker_idle", std::chrono::nanoseconds(_workerData[i]->IdleTime.exchange(0)),
+            METRIC_TAG("worker", std::to_string(i)));
+    }
+}
+
+void MapUpdater::InitializeThread(std::size_t index)
 {
     AuthDatabase.WarnAboutSyncQueries(true);
     CharacterDatabase.WarnAboutSyncQueries(true);
     WorldDatabase.WarnAboutSyncQueries(true);
 
+    WorkerData& worker = *_workerData[index];
+
     for (;;)
     {
         UpdateRequest* request = nullptr;
 
+        TimePoint idleStart = std::chrono::steady_clock::now();
         _queue.WaitAndPop(request);
+        worker.IdleTime += GetElapsedNs(idleStart);
+
         if (_cancelationToken)
             return;
 
+        TimePoint busyStart = std::chrono::steady_clock::now();
+        request->UpdateMap();
+        delete request;
+        worker.BusyTime += GetElapsedNs(busyStart);
+    }
+}
+
+void MapUpdater::WorkStealingThread(std::size_t index)
+{
+    AuthDatabase.WarnAboutSyncQueries(true);
+    CharacterDatabase.WarnAboutSyncQueries(true);
+    WorldDatabase.WarnAboutSyncQueries(true);
+
+    _workerIndex = index;
+    WorkerData& worker = *_workerData[index];
+
+    for (;;)
+    {
+        UpdateRequest* request = PopOrSteal(index);
+        if (!request)
+        {
+            TimePoint idleStart = std::chrono::steady_clock::now();
+
+            {
+                std::unique_lock<std::mutex> guard(_wakeLock);
+                _wakeCondition.wait(guard, [this]() { return _cancelationToken || _queuedRequests; });
+            }
+
+            worker.IdleTime += GetElapsedNs(idleStart);
+
+            if (_cancelationToken)
+                return;
+
+            continue;
+        }
+
+        TimePoint busyStart = std::chrono::steady_clock::now();
         request->UpdateMap();
         delete request;
+        worker.BusyTime += GetElapsedNs(busyStart);
     }
 }
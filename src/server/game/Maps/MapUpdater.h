@@ -20,11 +20,21 @@
 
 #include "Define.h"
 #include "PCQueue.h"
+#include <deque>
+#include <functional>
+#include <memory>
 #include <thread>
+#include <vector>
 
 class Map;
 class UpdateRequest;
 
+enum class MapUpdaterScheduler : uint8
+{
+    Queue,          // single shared queue, requests are taken in schedule order
+    WorkStealing    // per-thread deques filled by previous update cost, idle threads steal from busy ones
+};
+
 class WH_GAME_API MapUpdater
 {
 public:
@@ -33,20 +43,45 @@ public:
 
     void ScheduleUpdate(Map& map, uint32 diff, uint32 s_diff);
     void ScheduleLfgUpdate(uint32 diff);
+    void ScheduleTask(std::function<void()>&& task);
+    void StartScheduled();
     void WaitThreads();
-    void InitThreads(std::size_t num_threads);
+    void InitThreads(std::size_t num_threads, MapUpdaterScheduler scheduler = MapUpdaterScheduler::Queue);
     void Stop();
     bool IsActive();
+    std::size_t GetThreadsCount() const { return _workerThreads.size(); }
     void FinishUpdate();
 
 private:
-    void InitializeThread();
+    struct WorkerData
+    {
+        std::mutex Lock;
+        std::deque<UpdateRequest*> Requests;  // front - most expensive, stolen from the back
+        std::atomic<int64> BusyTime{};        // nanoseconds since last metric report
+        std::atomic<int64> IdleTime{};
+    };
 
+    void InitializeThread(std::size_t index);
+    void WorkStealingThread(std::size_t index);
+    void Push(UpdateRequest* request);
+    void DispatchScheduled();
+    UpdateRequest* PopOrSteal(std::size_t index);
+    void LogWorkerMetrics();
+
+    MapUpdaterScheduler _scheduler{ MapUpdaterScheduler::Queue };
     ProducerConsumerQueue<UpdateRequest*> _queue;
 
     std::vector<std::thread> _workerThreads;
+    std::vector<std::unique_ptr<WorkerData>> _workerData;
     std::atomic<bool> _cancelationToken;
 
+    // work stealing
+    std::vector<UpdateRequest*> _scheduledRequests;
+    std::atomic<std::size_t> _queuedRequests{};
+    std::atomic<std::size_t> _nextWorker{};
+    std::mutex _wakeLock;
+    std::condition_variable _wakeCondition;
+
     std::mutex _lock;
     std::condition_variable _condition;
     std::size_t pending_requests{};
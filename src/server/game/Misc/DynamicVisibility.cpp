@@ -19,13 +19,61 @@
 // PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 
 #include "DynamicVisibility.h"
+#include "GameConfig.h"
+#include <algorithm>
+#include <cmath>
 
 uint8 DynamicVisibilityMgr::visibilitySettingsIndex = 0;
+std::atomic<uint32> DynamicVisibilityMgr::worldUpdateTime{};
 
-void DynamicVisibilityMgr::Update(uint32 sessionCount)
+void DynamicVisibilityMgr::Update(uint32 sessionCount, uint32 lastWorldUpdateTime)
 {
+    worldUpdateTime.store(lastWorldUpdateTime, std::memory_order_relaxed);
+
     if (sessionCount >= (visibilitySettingsIndex + 1) * ((uint32)VISIBILITY_SETTINGS_PLAYER_INTERVAL) && visibilitySettingsIndex < VISIBILITY_SETTINGS_MAX_INTERVAL_NUM - 1)
         ++visibilitySettingsIndex;
     else if (visibilitySettingsIndex && sessionCount < visibilitySettingsIndex * ((uint32)VISIBILITY_SETTINGS_PLAYER_INTERVAL) - 100)
         --visibilitySettingsIndex;
 }
+
+void DynamicVisibilityController::Update(uint32 mapType, uint32 diff, Microseconds mapUpdateDuration)
+{
+    _incrementalUpdate = CONF_GET_BOOL("Visibility.Incremental");
+    _fullUpdateInterval = CONF_GET_UINT("Visibility.Incremental.FullUpdateInterval");
+
+    if (!CONF_GET_BOOL("Visibility.Dynamic.Feedback"))
+    {
+        _settings = DynamicVisibilityMgr::GetSettings(mapType);
+        _pressure = 0.0f;
+        _load = 0.0f;
+        return;
+    }
+
+    float mapTarget = float(std::max<uint32>(CONF_GET_UINT("Visibility.Dynamic.MapUpdateTarget"), 1));
+    float worldTarget = float(std::max<uint32>(CONF_GET_UINT("Visibility.Dynamic.WorldUpdateTarget"), 1));
+    float pressure = std::max(float(mapUpdateDuration.count()) / 1000.0f / mapTarget, float(DynamicVisibilityMgr::GetWorldUpdateTime()) / worldTarget);
+
+    // single slow ticks (grid loading, instance creation) should not kick in degradation
+    _pressure += (pressure - _pressure) * 0.1f;
+
+    // degrade in proportion to the overload, recover slowly and only well below the target to avoid oscillating
+    float seconds = float(diff) / 1000.0f;
+    if (_pressure > 1.0f)
+        _load = std::min(1.0f, _load + (_pressure - 1.0f) * seconds);
+    else if (_pressure < 0.75f)
+        _load = std::max(0.0f, _load - 0.05f * seconds);
+
+    VisibilitySettingData const& best = VisibilitySettings[0][mapType];
+    VisibilitySettingData const& worst = VisibilitySettings[VISIBILITY_SETTINGS_MAX_INTERVAL_NUM - 1][mapType];
+
+    uint32 maxNotifyDelay = std::max(best.visibilityNotifyDelay, std::min(worst.visibilityNotifyDelay, CONF_GET_UINT("Visibility.Dynamic.MaxNotifyDelay")));
+    uint32 maxAINotifyDelay = std::max(best.aiNotifyDelay, std::min(worst.aiNotifyDelay, CONF_GET_UINT("Visibility.Dynamic.MaxAINotifyDelay")));
+    float minMoveDist = std::sqrt(best.requiredMoveDistanceSq);
+    float maxMoveDist = std::max(minMoveDist, std::min(std::sqrt(worst.requiredMoveDistanceSq), CONF_GET_FLOAT("Visibility.Dynamic.MaxMoveDistance")));
+
+    _settings.visibilityNotifyDelay = best.visibilityNotifyDelay + uint32(float(maxNotifyDelay - best.visibilityNotifyDelay) * _load);
+    _settings.aiNotifyDelay = best.aiNotifyDelay + uint32(float(maxAINotifyDelay - best.aiNotifyDelay) * _load);
+
+    float moveDist = minMoveDist + (maxMoveDist - minMoveDist) * _load;
+    _settings.requiredMoveDistanceSq = moveDist * moveDist;
+}
@@ -19,6 +19,8 @@
 #define __DYNAMICVISIBILITY_H
 
 #include "Common.h"
+#include "Duration.h"
+#include <atomic>
 
 struct VisibilitySettingData
 {
@@ -47,12 +49,41 @@ const VisibilitySettingData VisibilitySettings[VISIBILITY_SETTINGS_MAX_INTERVAL_
 class DynamicVisibilityMgr
 {
 public:
-    static void Update(uint32 sessionCount);
+    static void Update(uint32 sessionCount, uint32 worldUpdateTime);
+    static VisibilitySettingData const& GetSettings(uint32 map_type) { return VisibilitySettings[visibilitySettingsIndex][map_type]; }
     static uint32 GetVisibilityNotifyDelay(uint32 map_type) { return VisibilitySettings[visibilitySettingsIndex][map_type].visibilityNotifyDelay; }
     static uint32 GetAINotifyDelay(uint32 map_type) { return VisibilitySettings[visibilitySettingsIndex][map_type].aiNotifyDelay; }
     static float GetReqMoveDistSq(uint32 map_type) { return VisibilitySettings[visibilitySettingsIndex][map_type].requiredMoveDistanceSq; }
+    static uint32 GetWorldUpdateTime() { return worldUpdateTime.load(std::memory_order_relaxed); }
 protected:
     static uint8 visibilitySettingsIndex;
+    static std::atomic<uint32> worldUpdateTime; // written by the world thread, read by the map threads
+};
+
+// Per map feedback controller, with Visibility.Dynamic.Feedback enabled it trades visibility update frequency
+// for update time: settings degrade from the first row of VisibilitySettings towards the last one while the map
+// or world update exceeds its target and recover once both are comfortably below it again.
+// Otherwise it follows DynamicVisibilityMgr's session count based settings.
+class DynamicVisibilityController
+{
+public:
+    DynamicVisibilityController() = default;
+
+    void Update(uint32 mapType, uint32 diff, Microseconds mapUpdateDuration);
+
+    [[nodiscard]] uint32 GetVisibilityNotifyDelay() const { return _settings.visibilityNotifyDelay; }
+    [[nodiscard]] uint32 GetAINotifyDelay() const { return _settings.aiNotifyDelay; }
+    [[nodiscard]] float GetReqMoveDistSq() const { return _settings.requiredMoveDistanceSq; }
+    [[nodiscard]] float GetLoad() const { return _load; }
+    [[nodiscard]] bool IsIncrementalUpdateEnabled() const { return _incrementalUpdate; }
+    [[nodiscard]] uint32 GetFullUpdateInterval() const { return _fullUpdateInterval; }
+
+private:
+    float _pressure{0.0f}; // smoothed ratio of measured to target update time, 1.0 - on target
+    float _load{0.0f};     // 0.0 - best settings for the map type, 1.0 - cheapest allowed ones
+    VisibilitySettingData _settings{VisibilitySettings[0][0]};
+    bool _incrementalUpdate{false};  // Visibility.Incremental
+    uint32 _fullUpdateInterval{0};   // Visibility.Incremental.FullUpdateInterval
 };
 
 #endif
@@ -37,16 +37,19 @@ PathGenerator::PathGenerator(WorldObject const* owner) :
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
-    uint32 mapId = _source->GetMapId();
-    {
-        MMAP::MMapMgr* mmap = MMAP::MMapFactory::createOrGetMMapMgr();
-        _navMesh = mmap->GetNavMesh(mapId);
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _source->GetInstanceId());
-    }
+    _navMesh = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMesh(_source->GetMapId());
 
     CreateFilter();
 }
 
+void PathGenerator::UpdateNavMeshQuery()
+{
+    // Generators outlive a tick and the region workers get their slots again every sharded update,
+    // so the query is picked for the thread running this calculation, the map keeps them resolved
+    Map* map = _source->FindMap();
+    _navMeshQuery = _navMesh && map ? map->GetNavMeshQuery() : nullptr;
+}
+
 PathGenerator::~PathGenerator()
 {
 }
@@ -74,6 +77,8 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
 
     _forceDestination = forceDest;
 
+    UpdateNavMeshQuery();
+
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
     Unit const* _sourceUnit = _source->ToUnit();
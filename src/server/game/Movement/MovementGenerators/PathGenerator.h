@@ -146,7 +146,7 @@ class WH_GAME_API PathGenerator
 
         WorldObject const* const _source;       // the object that is moving
         dtNavMesh const* _navMesh;              // the nav mesh
-        dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path
+        dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query of the calculating thread, set by every CalculatePath
 
         dtQueryFilterExt _filter;  // use single filter for all movements, update it when needed
 
@@ -168,6 +168,7 @@ class WH_GAME_API PathGenerator
         void BuildShortcut();
 
         [[nodiscard]] NavTerrain GetNavTerrain(float x, float y, float z) const;
+        void UpdateNavMeshQuery();
         void CreateFilter();
         void UpdateFilter();
 
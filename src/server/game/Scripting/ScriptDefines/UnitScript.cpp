@@ -171,6 +171,11 @@ bool ScriptMgr::OnBuildValuesUpdate(Unit const* unit, uint8 updateType, ByteBuff
     return ReturnValidBool(ret, true);
 }
 
+bool ScriptMgr::HasUnitScripts()
+{
+    return !ScriptRegistry<UnitScript>::Instance()->GetScripts().empty();
+}
+
 void ScriptMgr::OnUnitUpdate(Unit* unit, uint32 diff)
 {
     ExecuteScript<UnitScript>([&](UnitScript* script)
@@ -515,6 +515,7 @@ public: /* UnitScript */
     bool CanSetPhaseMask(Unit const* unit, uint32 newPhaseMask, bool update);
     bool IsCustomBuildValuesUpdate(Unit const* unit, uint8 updateType, ByteBuffer* fieldBuffer, Player const* target, uint16 index);
     bool OnBuildValuesUpdate(Unit const* unit, uint8 updateType, ByteBuffer* fieldBuffer, Player* target, uint16 index);
+    bool HasUnitScripts();
     void OnUnitUpdate(Unit* unit, uint32 diff);
     void OnDisplayIdChange(Unit* unit, uint32 displayId);
     void OnUnitEnterEvadeMode(Unit* unit, uint8 why);
@@ -33,19 +33,20 @@ public:
         ByteBuffer(res), m_opcode(opcode) { }
 
     WorldPacket(WorldPacket&& packet) noexcept :
-        ByteBuffer(std::move(packet)), m_opcode(packet.m_opcode) { }
+        ByteBuffer(std::move(packet)), m_opcode(packet.m_opcode), m_compressionLevel(packet.m_compressionLevel) { }
 
     WorldPacket(WorldPacket&& packet, TimePoint receivedTime) :
         ByteBuffer(std::move(packet)), m_opcode(packet.m_opcode), m_receivedTime(receivedTime) { }
 
     WorldPacket(WorldPacket const& right) :
-        ByteBuffer(right), m_opcode(right.m_opcode) { }
+        ByteBuffer(right), m_opcode(right.m_opcode), m_compressionLevel(right.m_compressionLevel) { }
 
     WorldPacket& operator=(WorldPacket const& right)
     {
         if (this != &right)
         {
             m_opcode = right.m_opcode;
+            m_compressionLevel = right.m_compressionLevel;
             ByteBuffer::operator=(right);
         }
 
@@ -57,6 +58,7 @@ public:
         if (this != &right)
         {
             m_opcode = right.m_opcode;
+            m_compressionLevel = right.m_compressionLevel;
             ByteBuffer::operator=(std::move(right));
         }
 
@@ -71,6 +73,7 @@ public:
         clear();
         _storage.reserve(newres);
         m_opcode = opcode;
+        m_compressionLevel = 0;
     }
 
     [[nodiscard]] uint16 GetOpcode() const { return m_opcode; }
@@ -78,8 +81,13 @@ public:
 
     [[nodiscard]] TimePoint GetReceivedTime() const { return m_receivedTime; }
 
+    /// zlib level the network thread compresses the packet with before sending it, 0 - sent as it is
+    [[nodiscard]] uint8 GetDeferredCompressionLevel() const { return m_compressionLevel; }
+    void SetDeferredCompressionLevel(uint8 level) { m_compressionLevel = level; }
+
 protected:
     uint16 m_opcode{NULL_OPCODE};
+    uint8 m_compressionLevel{0};
     TimePoint m_receivedTime; // only set for a specific set of opcodes, for performance reasons.
 };
 
@@ -212,17 +212,45 @@ ObjectGuid::LowType WorldSession::GetGuidLow() const
     return GetPlayer() ? GetPlayer()->GetGUID().GetCounter() : 0;
 }
 
+/// Copy the packet once into a buffer that all receiving sockets queue without copying it again
+std::shared_ptr<WorldPacket const> const& SharedWorldPacket::Share() const
+{
+    if (!_sharedPacket)
+    {
+        _sharedPacket = std::make_shared<WorldPacket const>(_packet);
+        WorldSocket::AddCopiedPacketBytes(_packet.size());
+    }
+
+    return _sharedPacket;
+}
+
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const* packet)
+{
+    if (!CanSendPacket(packet))
+        return;
+
+    m_Socket->SendPacket(*packet);
+}
+
+void WorldSession::SendPacket(SharedWorldPacket const& packet)
+{
+    if (!CanSendPacket(&packet.GetPacket()))
+        return;
+
+    m_Socket->SendPacket(packet.Share());
+}
+
+bool WorldSession::CanSendPacket(WorldPacket const* packet)
 {
     if (packet->GetOpcode() == NULL_OPCODE)
     {
         LOG_ERROR("network.opcode", "{} send NULL_OPCODE", GetPlayerInfo());
-        return;
+        return false;
     }
 
     if (!m_Socket)
-        return;
+        return false;
 
 #if defined(ENABLE_EXTRAS) && defined(ENABLE_EXTRA_LOGS) && defined(WARHEAD_DEBUG)
     // Code for network use statistic
@@ -262,11 +290,11 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 
     if (!sScriptMgr->CanPacketSend(this, *packet))
     {
-        return;
+        return false;
     }
 
     LOG_TRACE("network.opcode", "S->C: {} {}", GetPlayerInfo(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())));
-    m_Socket->SendPacket(*packet);
+    return true;
 }
 
 /// Add an incoming packet to the queue
@@ -331,6 +331,21 @@ protected:
     bool FactionChange = false;
 };
 
+/// Packet sent unchanged to many sessions, the body is copied once on first send
+/// and the copy is shared by the queues of all receiving sockets
+class WH_GAME_API SharedWorldPacket
+{
+public:
+    explicit SharedWorldPacket(WorldPacket const& packet) : _packet(packet) { }
+
+    WorldPacket const& GetPacket() const { return _packet; }
+    std::shared_ptr<WorldPacket const> const& Share() const;
+
+private:
+    WorldPacket const& _packet;
+    mutable std::shared_ptr<WorldPacket const> _sharedPacket;
+};
+
 struct PacketCounter
 {
     time_t lastReceiveTime;
@@ -356,6 +371,7 @@ public:
     void WriteMovementInfo(WorldPacket* data, MovementInfo* mi);
 
     void SendPacket(WorldPacket const* packet);
+    void SendPacket(SharedWorldPacket const& packet);
 
     void SendPetNameInvalid(uint32 error, std::string const& name, DeclinedName* declinedName);
     void SendPartyResult(PartyOperation operation, std::string const& member, PartyResult res, uint32 val = 0);
@@ -1119,6 +1135,8 @@ protected:
     } AntiDOS;
 
 private:
+    bool CanSendPacket(WorldPacket const* packet);
+
     // private trade methods
     void moveItems(Item* myItems[], Item* hisItems[]);
 
@@ -33,12 +33,31 @@
 #include "PacketLog.h"
 #include "Realm.h"
 #include "ScriptMgr.h"
+#include "UpdateData.h"
 #include "World.h"
 #include "WorldSession.h"
 #include <memory>
 
 using boost::asio::ip::tcp;
 
+void EncryptablePacket::CompressIfDeferred()
+{
+    WorldPacket const& packet = GetPacket();
+    if (!packet.GetDeferredCompressionLevel())
+        return;
+
+    // on failure the uncompressed SMSG_UPDATE_OBJECT is still valid to send
+    WorldPacket compressed;
+    if (!UpdateData::CompressPacket(&compressed, packet, packet.GetDeferredCompressionLevel()))
+        return;
+
+    _packet = std::move(compressed);
+    _sharedPacket.reset();
+}
+
+std::atomic<uint64> WorldSocket::_copiedPacketBytes{};
+std::atomic<uint64> WorldSocket::_sharedPacketBytes{};
+
 WorldSocket::WorldSocket(tcp::socket&& socket)
     : Socket(std::move(socket)), _OverSpeedPings(0), _worldSession(nullptr), _authed(false), _sendBufferSize(4096)
 {
@@ -110,6 +129,8 @@ bool WorldSocket::Update()
     MessageBuffer buffer(_sendBufferSize);
     while (_bufferQueue.Dequeue(queued))
     {
+        queued->CompressIfDeferred();
+
         ServerPktHeader header(queued->size() + 2, queued->GetOpcode());
         if (queued->NeedsEncryption())
             _authCrypt.EncryptSend(header.header, header.getHeaderLength());
@@ -446,6 +467,19 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
 
+    _copiedPacketBytes += packet.size();
+    _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
+}
+
+void WorldSocket::SendPacket(std::shared_ptr<WorldPacket const> const& packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket())
+        sPacketLog->LogPacket(*packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
+
+    _sharedPacketBytes += packet->size();
     _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
 }
 
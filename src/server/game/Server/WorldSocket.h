@@ -29,19 +29,37 @@
 
 using boost::asio::ip::tcp;
 
-class EncryptablePacket : public WorldPacket
+/// Queued outgoing packet, the body is either an own copy or shared with the queues of other sockets
+/// (broadcasts), only the header is built and encrypted per socket
+class EncryptablePacket
 {
 public:
-    EncryptablePacket(WorldPacket const& packet, bool encrypt) : WorldPacket(packet), _encrypt(encrypt)
+    EncryptablePacket(WorldPacket const& packet, bool encrypt) : _packet(packet), _encrypt(encrypt)
     {
         SocketQueueLink.store(nullptr, std::memory_order_relaxed);
     }
 
+    EncryptablePacket(std::shared_ptr<WorldPacket const> packet, bool encrypt) : _sharedPacket(std::move(packet)), _encrypt(encrypt)
+    {
+        SocketQueueLink.store(nullptr, std::memory_order_relaxed);
+    }
+
+    WorldPacket const& GetPacket() const { return _sharedPacket ? *_sharedPacket : _packet; }
+    uint16 GetOpcode() const { return GetPacket().GetOpcode(); }
+    std::size_t size() const { return GetPacket().size(); }
+    bool empty() const { return GetPacket().empty(); }
+    uint8 const* contents() const { return GetPacket().contents(); }
+
     bool NeedsEncryption() const { return _encrypt; }
 
+    /// compresses update packets the map threads left for the network thread, see UpdateData::BuildPacket
+    void CompressIfDeferred();
+
     std::atomic<EncryptablePacket*> SocketQueueLink;
 
 private:
+    WorldPacket _packet;
+    std::shared_ptr<WorldPacket const> _sharedPacket;
     bool _encrypt;
 };
 
@@ -79,6 +97,12 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    void SendPacket(std::shared_ptr<WorldPacket const> const& packet);
+
+    /// packet body bytes copied into socket queues / queued by reference to a shared body
+    static void AddCopiedPacketBytes(std::size_t bytes) { _copiedPacketBytes += bytes; }
+    static uint64 GetCopiedPacketBytes() { return _copiedPacketBytes; }
+    static uint64 GetSharedPacketBytes() { return _sharedPacketBytes; }
 
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
 
@@ -130,6 +154,9 @@ private:
 
     QueryCallbackProcessor _queryProcessor;
     std::string _ipCountry;
+
+    static std::atomic<uint64> _copiedPacketBytes;
+    static std::atomic<uint64> _sharedPacketBytes;
 };
 
 #endif
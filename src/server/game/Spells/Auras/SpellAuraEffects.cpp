@@ -430,6 +430,25 @@ void AuraEffect::GetApplicationList(std::list<AuraApplication*>& applicationList
     }
 }
 
+void AuraEffect::InvalidateTargetModifierCaches()
+{
+    for (auto const& [guid, aurApp] : GetBase()->GetApplicationMap())
+        aurApp->GetTarget()->InvalidateAuraModifierCache(GetAuraType());
+}
+
+void AuraEffect::SetAmount(int32 amount)
+{
+    m_amount = amount;
+    m_canBeRecalculated = false;
+    InvalidateTargetModifierCaches();
+}
+
+void AuraEffect::SetEnabled(bool enabled)
+{
+    m_isAuraEnabled = enabled;
+    InvalidateTargetModifierCaches();
+}
+
 uint32 AuraEffect::GetId() const
 {
     return m_spellInfo->Id;
@@ -722,7 +741,10 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
     if (handleMask & AURA_EFFECT_HANDLE_CHANGE_AMOUNT)
     {
         if (!mark)
+        {
             m_amount = newAmount;
+            InvalidateTargetModifierCaches();
+        }
         else
             SetAmount(newAmount);
         CalculateSpellMod();
@@ -2440,6 +2462,7 @@ void AuraEffect::HandleFeignDeath(AuraApplication const* aurApp, uint8 mode, boo
         UnitList targets;
         Warhead::AnyUnfriendlyUnitInObjectRangeCheck u_check(target, target, target->GetVisibilityRange()); // no VISIBILITY_COMPENSATION, distance is enough
         Warhead::UnitListSearcher<Warhead::AnyUnfriendlyUnitInObjectRangeCheck> searcher(target, targets, u_check);
+        searcher.i_searchArea.Set(target, target->GetVisibilityRange());
         Cell::VisitAllObjects(target, searcher, target->GetMap()->GetVisibilityRange());
         for (UnitList::iterator iter = targets.begin(); iter != targets.end(); ++iter)
         {
@@ -41,8 +41,16 @@ class WH_GAME_API AuraEffect
     friend Aura* Unit::_TryStackingOrRefreshingExistingAura(SpellInfo const* newAura, uint8 effMask, Unit* caster, int32* baseAmount, Item* castItem, ObjectGuid casterGUID, bool noPeriodicReset);
     friend Aura::~Aura();
 
+public:
+    // Allocated from SpellAuraPool
+    static void* operator new(std::size_t size) { return SpellAuraPool::Allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { SpellAuraPool::Deallocate(ptr, size); }
+
 private:
     ~AuraEffect();
+
+    // GetAmount changed, the cached aura modifiers of the targets are stale
+    void InvalidateTargetModifierCaches();
     explicit AuraEffect(Aura* base, uint8 effIndex, int32* baseAmount, Unit* caster);
 
 public:
@@ -64,7 +72,7 @@ public:
     AuraType GetAuraType() const;
     int32 GetAmount() const { return m_isAuraEnabled ? m_amount : 0; }
     int32 GetForcedAmount() const { return m_amount; }
-    void SetAmount(int32 amount) { m_amount = amount; m_canBeRecalculated = false;}
+    void SetAmount(int32 amount);
 
     int32 GetPeriodicTimer() const { return m_periodicTimer; }
     void SetPeriodicTimer(int32 periodicTimer) { m_periodicTimer = periodicTimer; }
@@ -116,7 +124,7 @@ public:
     uint32 GetAuraGroup() const { return m_auraGroup; }
     int32 GetOldAmount() const { return m_oldAmount; }
     void SetOldAmount(int32 amount) { m_oldAmount = amount; }
-    void SetEnabled(bool enabled) { m_isAuraEnabled = enabled; }
+    void SetEnabled(bool enabled);
 
 private:
     Aura* const m_base;
@@ -0,0 +1,114 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include "SpellAuraPool.h"
+#include <array>
+#include <new>
+
+namespace
+{
+    constexpr std::size_t BLOCK_GRANULARITY = 16;
+    constexpr std::size_t MAX_BLOCK_SIZE = 1024;
+    constexpr uint32 MAX_FREE_BLOCKS = 4096;    // per size, anything above goes back to the heap
+
+    struct FreeBlock
+    {
+        FreeBlock* Next;
+    };
+
+    struct FreeList
+    {
+        FreeBlock* Head{ nullptr };
+        uint32 Count{ 0 };
+    };
+
+    struct ThreadPool
+    {
+        std::array<FreeList, MAX_BLOCK_SIZE / BLOCK_GRANULARITY> Lists{};
+
+        ~ThreadPool();
+    };
+
+    // trivially destructible, still readable while other thread locals are destroyed
+    thread_local bool PoolDestroyed = false;
+    thread_local ThreadPool Pool;
+
+    ThreadPool::~ThreadPool()
+    {
+        PoolDestroyed = true;
+
+        for (FreeList& list : Lists)
+        {
+            while (FreeBlock* block = list.Head)
+            {
+                list.Head = block->Next;
+                ::operator delete(block);
+            }
+        }
+    }
+
+    inline std::size_t GetListIndex(std::size_t size)
+    {
+        return (size + BLOCK_GRANULARITY - 1) / BLOCK_GRANULARITY - 1;
+    }
+}
+
+void* SpellAuraPool::Allocate(std::size_t size)
+{
+    if (!size || size > MAX_BLOCK_SIZE || PoolDestroyed)
+        return ::operator new(size);
+
+    std::size_t index = GetListIndex(size);
+    FreeList& list = Pool.Lists[index];
+
+    if (FreeBlock* block = list.Head)
+    {
+        list.Head = block->Next;
+        --list.Count;
+        return block;
+    }
+
+    // whole blocks, a freed block serves every size of its list
+    return ::operator new((index + 1) * BLOCK_GRANULARITY);
+}
+
+void SpellAuraPool::Deallocate(void* ptr, std::size_t size)
+{
+    if (!ptr)
+        return;
+
+    if (!size || size > MAX_BLOCK_SIZE || PoolDestroyed)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    FreeList& list = Pool.Lists[GetListIndex(size)];
+    if (list.Count >= MAX_FREE_BLOCKS)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->Next = list.Head;
+    list.Head = block;
+    ++list.Count;
+}
@@ -0,0 +1,39 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WARHEAD_SPELLAURAPOOL_H
+#define WARHEAD_SPELLAURAPOOL_H
+
+#include "Define.h"
+#include <cstddef>
+
+/*
+  Free lists for the objects of auras (Aura, AuraEffect, AuraApplication), which are created
+  and deleted at a high rate. The lists belong to a thread, not to a map: a map can be updated
+  by another map thread on every tick when the updater steals work, and it simply uses the lists
+  of the thread running it. Each list is only touched by its own thread, so no locking is needed.
+  A block freed on another thread than the one it came from joins the lists of the freeing thread.
+  Blocks are rounded up to 16 bytes, larger than 1024 bytes go to the heap directly, and each
+  size keeps at most 4096 free blocks.
+*/
+namespace SpellAuraPool
+{
+    WH_GAME_API void* Allocate(std::size_t size);
+    WH_GAME_API void Deallocate(void* ptr, std::size_t size);
+}
+
+#endif
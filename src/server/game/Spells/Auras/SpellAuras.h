@@ -19,6 +19,7 @@
 #define WARHEAD_SPELLAURAS_H
 
 #include "SpellAuraDefines.h"
+#include "SpellAuraPool.h"
 #include "Unit.h"
 
 class Unit;
@@ -41,6 +42,11 @@ class WH_GAME_API AuraApplication
     friend void Unit::RemoveAura(AuraApplication* aurApp, AuraRemoveMode mode);
     friend AuraApplication* Unit::_CreateAuraApplication(Aura* aura, uint8 effMask);
 
+public:
+    // Allocated from SpellAuraPool
+    static void* operator new(std::size_t size) { return SpellAuraPool::Allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { SpellAuraPool::Deallocate(ptr, size); }
+
 private:
     Unit* const _target;
     Aura* const _base;
@@ -90,6 +96,10 @@ class WH_GAME_API Aura
 public:
     typedef std::map<ObjectGuid, AuraApplication*> ApplicationMap;
 
+    // Allocated from SpellAuraPool
+    static void* operator new(std::size_t size) { return SpellAuraPool::Allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { SpellAuraPool::Deallocate(ptr, size); }
+
     static uint8 BuildEffectMaskForOwner(SpellInfo const* spellProto, uint8 avalibleEffectMask, WorldObject* owner);
     static Aura* TryRefreshStackOrCreate(SpellInfo const* spellproto, uint8 tryEffMask, WorldObject* owner, Unit* caster, int32* baseAmount = nullptr, Item* castItem = nullptr, ObjectGuid casterGUID = ObjectGuid::Empty, bool* refresh = nullptr, bool periodicReset = false);
     static Aura* TryCreate(SpellInfo const* spellproto, uint8 effMask, WorldObject* owner, Unit* caster, int32* baseAmount = nullptr, Item* castItem = nullptr, ObjectGuid casterGUID = ObjectGuid::Empty, ObjectGuid itemGUID = ObjectGuid::Empty);
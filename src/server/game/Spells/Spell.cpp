@@ -2164,9 +2164,15 @@ void Spell::SearchTargets(SEARCHER& searcher, uint32 containerMask, Unit* refere
 
         Map* map = referer->GetMap();
 
+        // all spell target checks measure to the target's bounding circle, except gameobjects which use their display box
+        searcher.i_searchArea.Set(x, y, radius);
+
         if (searchInWorld)
             Cell::VisitWorldObjects(x, y, map, searcher, radius);
 
+        if (containerMask & GRID_MAP_TYPE_MASK_GAMEOBJECT)
+            searcher.i_searchArea.Radius = 0.0f;
+
         if (searchInGrid)
             Cell::VisitGridObjects(x, y, map, searcher, radius);
     }
@@ -0,0 +1,147 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include "LoaderGraph.h"
+#include "Errors.h"
+#include "Log.h"
+#include "StopWatch.h"
+#include "Timer.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+void LoaderGraph::Add(std::string name, Loader loader, std::vector<std::string> const& dependencies /*= {}*/)
+{
+    std::size_t index = _nodes.size();
+    Node& node = _nodes.emplace_back();
+    node.Name = std::move(name);
+    node.Function = std::move(loader);
+
+    for (std::string const& dependency : dependencies)
+    {
+        auto itr = std::find_if(_nodes.begin(), _nodes.begin() + index, [&dependency](Node const& other) { return other.Name == dependency; });
+        ASSERT(itr != _nodes.begin() + index, "Loader '{}' depends on unknown loader '{}'", _nodes[index].Name, dependency);
+
+        itr->Dependents.push_back(index);
+        ++_nodes[index].DependencyCount;
+    }
+}
+
+void LoaderGraph::Run(uint32 threads)
+{
+    if (_nodes.empty())
+        return;
+
+    StopWatch sw;
+
+    std::size_t threadCount = std::clamp<std::size_t>(threads, 1, _nodes.size());
+    std::vector<uint32> pending(_nodes.size());
+    std::vector<Microseconds> durations(_nodes.size());
+    std::set<std::size_t> ready;    // lowest index first, with one thread this is the order of Add
+    std::size_t finished = 0;
+    std::mutex lock;
+    std::condition_variable condition;
+
+    for (std::size_t i = 0; i < _nodes.size(); ++i)
+    {
+        pending[i] = _nodes[i].DependencyCount;
+        if (!pending[i])
+            ready.insert(i);
+    }
+
+    auto worker = [&]()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+
+        for (;;)
+        {
+            condition.wait(guard, [&]() { return !ready.empty() || finished == _nodes.size(); });
+            if (ready.empty())
+                return;
+
+            std::size_t index = *ready.begin();
+            ready.erase(ready.begin());
+
+            guard.unlock();
+
+            StopWatch loaderSw;
+            _nodes[index].Function();
+            durations[index] = loaderSw.Elapsed();
+
+            guard.lock();
+
+            ++finished;
+            for (std::size_t dependent : _nodes[index].Dependents)
+                if (!--pending[dependent])
+                    ready.insert(dependent);
+
+            condition.notify_all();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+
+    for (std::size_t i = 1; i < threadCount; ++i)
+        workers.emplace_back(worker);
+
+    worker();
+
+    for (std::thread& thread : workers)
+        thread.join();
+
+    Microseconds total{ 0 };
+    for (std::size_t i = 0; i < _nodes.size(); ++i)
+    {
+        _timings.push_back({ std::move(_nodes[i].Name), durations[i] });
+        total += durations[i];
+    }
+
+    LOG_INFO("server.loading", ">> Ran {} loaders on {} threads in {} (sum of loader times {})",
+        _nodes.size(), threadCount, sw, Warhead::Time::ToTimeString(total));
+    LOG_INFO("server.loading", " ");
+
+    _nodes.clear();
+}
+
+void LoaderGraph::LogTimings(std::size_t count) const
+{
+    if (_timings.empty())
+        return;
+
+    std::vector<Timing const*> sorted;
+    sorted.reserve(_timings.size());
+
+    for (Timing const& timing : _timings)
+        sorted.push_back(&timing);
+
+    std::sort(sorted.begin(), sorted.end(), [](Timing const* left, Timing const* right) { return left->Duration > right->Duration; });
+
+    count = std::min(count, sorted.size());
+
+    LOG_INFO("server.loading", "Slowest {} of {} loaders:", count, sorted.size());
+
+    for (std::size_t i = 0; i < count; ++i)
+        LOG_INFO("server.loading", "    {:<40} {}", sorted[i]->Name, Warhead::Time::ToTimeString(sorted[i]->Duration));
+
+    LOG_INFO("server.loading", " ");
+}
@@ -0,0 +1,74 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _LOADER_GRAPH_H_
+#define _LOADER_GRAPH_H_
+
+#include "Define.h"
+#include "Duration.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+  Startup loaders with declared dependencies.
+  A loader starts once all the loaders it depends on have finished, independent loaders run
+  concurrently. Loaders only may touch data of other loaders they depend on (read only) and
+  their own stores. With one thread everything runs in the order it was added.
+*/
+class WH_GAME_API LoaderGraph
+{
+public:
+    using Loader = std::function<void()>;
+
+    struct Timing
+    {
+        std::string Name;
+        Microseconds Duration;
+    };
+
+    LoaderGraph() = default;
+
+    // Dependencies must be added before the loaders depending on them
+    void Add(std::string name, Loader loader, std::vector<std::string> const& dependencies = {});
+
+    // Runs every loader on up to threads threads (the calling one included), returns when all finished
+    void Run(uint32 threads);
+
+    [[nodiscard]] std::vector<Timing> const& GetTimings() const { return _timings; }
+    [[nodiscard]] std::size_t GetLoaderCount() const { return _nodes.size(); }
+
+    // Logs the slowest loaders of all runs
+    void LogTimings(std::size_t count) const;
+
+private:
+    struct Node
+    {
+        std::string Name;
+        Loader Function;
+        std::vector<std::size_t> Dependents;
+        uint32 DependencyCount{ 0 };
+    };
+
+    std::vector<Node> _nodes;
+    std::vector<Timing> _timings;
+
+    LoaderGraph(LoaderGraph const&) = delete;
+    LoaderGraph& operator=(LoaderGraph const&) = delete;
+};
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include "PlayerSaveScheduler.h"
+#include "DatabaseEnv.h"
+#include "GameConfig.h"
+#include "Metric.h"
+#include "World.h"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace
+{
+    constexpr uint32 METRIC_INTERVAL = 1000;
+}
+
+/*static*/ PlayerSaveScheduler* PlayerSaveScheduler::instance()
+{
+    static PlayerSaveScheduler instance;
+    return &instance;
+}
+
+void PlayerSaveScheduler::Update(uint32 diff)
+{
+    {
+        // completed saves release their slot here
+        std::lock_guard<std::mutex> guard(_callbackLock);
+        _callbacks.ProcessReadyCallbacks();
+    }
+
+    std::size_t queueSize = CharacterDatabase.GetQueueSize();
+    std::size_t connections = std::max<std::size_t>(CharacterDatabase.GetAsyncConnectionCount(), 1);
+    uint32 saveInterval = CONF_GET_INT("PlayerSaveInterval");
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        _enabled = CONF_GET_BOOL("PlayerSave.Scheduler.Enable");
+        _saveInterval = saveInterval;
+        _maxInFlight = uint32(connections) * std::max<uint32>(CONF_GET_UINT("PlayerSave.Scheduler.MaxInFlight"), 1);
+        _backoff = queueSize >= CONF_GET_UINT("PlayerSave.Scheduler.MaxQueueSize");
+
+        if (saveInterval)
+        {
+            // twice the average rate lets deferred saves catch up, a second worth of saves at most at once
+            double rate = 2.0 * sWorld->GetPlayerCount() / saveInterval;
+            _budget = std::min(_budget + rate * diff, std::max(1.0, rate * IN_MILLISECONDS));
+        }
+    }
+
+    _metricTimer += diff;
+    if (_metricTimer < METRIC_INTERVAL)
+        return;
+
+    _metricTimer = 0;
+
+    uint32 deferredSaves;
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        deferredSaves = std::exchange(_deferredSaves, 0);
+    }
+
+    METRIC_VALUE("db_queue_size", uint64(queueSize), METRIC_TAG("db", "character"));
+    METRIC_VALUE("player_save_in_flight", _inFlight.load());
+    METRIC_VALUE("player_save_deferred", deferredSaves);
+}
+
+bool PlayerSaveScheduler::TryStartSave(uint32 deferred)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    if (_enabled && deferred < _saveInterval && (_backoff || _budget < 1.0 || _inFlight >= _maxInFlight))
+    {
+        ++_deferredSaves;
+        return false;
+    }
+
+    _budget = std::max(_budget - 1.0, 0.0);
+    ++_inFlight;
+    return true;
+}
+
+void PlayerSaveScheduler::CommitSave(CharacterDatabaseTransaction trans, std::function<void(bool)> callback)
+{
+    // nothing was saved, e.g. delayed while teleporting far
+    if (!trans->GetSize())
+    {
+        --_inFlight;
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    TransactionCallback commit = CharacterDatabase.AsyncCommitTransaction(std::move(trans));
+    commit.AfterComplete([this, start, callback = std::move(callback)](bool success)
+    {
+        --_inFlight;
+
+        // measured when the world thread sees the result, at world update resolution
+        METRIC_VALUE("player_save_latency", uint64(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()));
+
+        callback(success);
+    });
+
+    std::lock_guard<std::mutex> guard(_callbackLock);
+    _callbacks.AddCallback(std::move(commit));
+}
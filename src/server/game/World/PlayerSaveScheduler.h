@@ -0,0 +1,76 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PLAYER_SAVE_SCHEDULER_H_
+#define _PLAYER_SAVE_SCHEDULER_H_
+
+#include "AsyncCallbackProcessor.h"
+#include "DatabaseEnvFwd.h"
+#include "Define.h"
+#include "Transaction.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+/*
+  Paces player autosaves across the whole world.
+  Saves are let through at twice the rate needed to save every online player once per
+  PlayerSaveInterval, at most PlayerSave.Scheduler.MaxInFlight save transactions per async
+  character database connection are pending at once and no save starts while the character
+  database queue is longer than PlayerSave.Scheduler.MaxQueueSize. A save that already waited
+  a whole save interval is never held back.
+*/
+class WH_GAME_API PlayerSaveScheduler
+{
+public:
+    static PlayerSaveScheduler* instance();
+
+    // World thread, before the maps are updated
+    void Update(uint32 diff);
+
+    // Map threads: true if a due autosave may start now, deferred is how long it already waited
+    bool TryStartSave(uint32 deferred);
+
+    // Commits the transaction of a save started by TryStartSave, callback gets the result on the world thread before the maps are updated
+    void CommitSave(CharacterDatabaseTransaction trans, std::function<void(bool)> callback);
+
+    [[nodiscard]] uint32 GetInFlightCount() const { return _inFlight; }
+
+private:
+    PlayerSaveScheduler() = default;
+    ~PlayerSaveScheduler() = default;
+
+    std::mutex _lock;
+    double _budget{ 0.0 };
+    uint32 _saveInterval{ 0 };
+    uint32 _maxInFlight{ 0 };
+    uint32 _deferredSaves{ 0 };
+    bool _enabled{ false };
+    bool _backoff{ false };
+    std::atomic<uint32> _inFlight{ 0 };
+
+    std::mutex _callbackLock;
+    TransactionCallbackProcessor _callbacks;
+    uint32 _metricTimer{ 0 };
+
+    PlayerSaveScheduler(PlayerSaveScheduler const&) = delete;
+    PlayerSaveScheduler& operator=(PlayerSaveScheduler const&) = delete;
+};
+
+#define sPlayerSaveScheduler PlayerSaveScheduler::instance()
+
+#endif
@@ -68,12 +68,14 @@
 #include "InstanceSaveMgr.h"
 #include "ItemEnchantmentMgr.h"
 #include "LFGMgr.h"
+#include "LoaderGraph.h"
 #include "Log.h"
 #include "LootItemStorage.h"
 #include "LootMgr.h"
 #include "M2Stores.h"
 #include "MMapFactory.h"
 #include "MapMgr.h"
+#include "MapUpdater.h"
 #include "Metric.h"
 #include "ModulesConfig.h"
 #include "MotdMgr.h"
@@ -83,6 +85,7 @@
 #include "PetitionMgr.h"
 #include "Player.h"
 #include "PlayerDump.h"
+#include "PlayerSaveScheduler.h"
 #include "PoolMgr.h"
 #include "Realm.h"
 #include "ScriptMgr.h"
@@ -110,6 +113,7 @@
 #include "WorldSession.h"
 #include <boost/asio/ip/address.hpp>
 #include <cmath>
+#include <thread>
 
 namespace
 {
@@ -917,86 +921,154 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server.loading", "Load Mail Server Template...");
     sObjectMgr->LoadMailServerTemplates();
 
+    LOG_INFO("server.loading", "Loading BattleMasters...");
+    sBattlegroundMgr->LoadBattleMastersEntry();                  // clears creature template npc flags, must not run together with the loaders below
+
+    ///- Independent stores, loaded in parallel
+    LoaderGraph loaders;
+
     // Loot tables
-    LoadLootTables();
+    loaders.Add("Creature Loot", &LoadLootTemplates_Creature);
+    loaders.Add("Fishing Loot", &LoadLootTemplates_Fishing);
+    loaders.Add("Gameobject Loot", &LoadLootTemplates_Gameobject);
+    loaders.Add("Item Loot", &LoadLootTemplates_Item);
+    loaders.Add("Mail Loot", &LoadLootTemplates_Mail);
+    loaders.Add("Milling Loot", &LoadLootTemplates_Milling);
+    loaders.Add("Pickpocketing Loot", &LoadLootTemplates_Pickpocketing);
+    loaders.Add("Skinning Loot", &LoadLootTemplates_Skinning);
+    loaders.Add("Disenchant Loot", &LoadLootTemplates_Disenchant);
+    loaders.Add("Prospecting Loot", &LoadLootTemplates_Prospecting);
+    loaders.Add("Spell Loot", &LoadLootTemplates_Spell);
+    loaders.Add("Reference Loot", &LoadLootTemplates_Reference,        // checks the references of all other loot stores
+        { "Creature Loot", "Fishing Loot", "Gameobject Loot", "Item Loot", "Mail Loot", "Milling Loot",
+          "Pickpocketing Loot", "Skinning Loot", "Disenchant Loot", "Prospecting Loot" });
+    loaders.Add("Player Loot", &LoadLootTemplates_Player);
 
-    LOG_INFO("server.loading", "Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
+    loaders.Add("Skill Discovery", []()
+    {
+        LOG_INFO("server.loading", "Loading Skill Discovery Table...");
+        LoadSkillDiscoveryTable();
+    });
 
-    LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
+    loaders.Add("Skill Extra Items", []()
+    {
+        LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
+        LoadSkillExtraItemTable();
+    });
 
-    LOG_INFO("server.loading", "Loading Skill Perfection Data Table...");
-    LoadSkillPerfectItemTable();
+    loaders.Add("Skill Perfection", []()
+    {
+        LOG_INFO("server.loading", "Loading Skill Perfection Data Table...");
+        LoadSkillPerfectItemTable();
+    });
 
-    LOG_INFO("server.loading", "Loading Skill Fishing Base Level Requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
+    loaders.Add("Fishing Base Skill", []()
+    {
+        LOG_INFO("server.loading", "Loading Skill Fishing Base Level Requirements...");
+        sObjectMgr->LoadFishingBaseSkillLevel();
+    });
 
-    LOG_INFO("server.loading", "Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
+    loaders.Add("Achievements", []()
+    {
+        LOG_INFO("server.loading", "Loading Achievements...");
+        sAchievementMgr->LoadAchievementReferenceList();
 
-    LOG_INFO("server", "Loading Achievement Criteria Lists...");
-    sAchievementMgr->LoadAchievementCriteriaList();
+        LOG_INFO("server", "Loading Achievement Criteria Lists...");
+        sAchievementMgr->LoadAchievementCriteriaList();
 
-    LOG_INFO("server", "Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
+        LOG_INFO("server", "Loading Achievement Criteria Data...");
+        sAchievementMgr->LoadAchievementCriteriaData();
 
-    LOG_INFO("server", "Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
+        LOG_INFO("server", "Loading Achievement Rewards...");
+        sAchievementMgr->LoadRewards();
 
-    LOG_INFO("server", "Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+        LOG_INFO("server", "Loading Completed Achievements...");
+        sAchievementMgr->LoadCompletedAchievements();
+    });
 
-    ///- Load dynamic data tables from the database
-    LOG_INFO("server.loading", "Loading Item Auctions...");
-    sAuctionMgr->LoadAuctionItems();
+    loaders.Add("Reserved Names", []()
+    {
+        LOG_INFO("server.loading", "Loading Reserved Names...");
+        sObjectMgr->LoadReservedPlayersNames();
+    });
 
-    LOG_INFO("server", "Loading Auctions...");
-    sAuctionMgr->LoadAuctions();
+    loaders.Add("Profanity Names", []()
+    {
+        LOG_INFO("server.loading", "Loading Profanity Names...");
+        sObjectMgr->LoadProfanityPlayersNames();
+    });
 
-    sGuildMgr->LoadGuilds();
+    loaders.Add("Game Teleports", []()
+    {
+        LOG_INFO("server.loading", "Loading GameTeleports...");
+        sObjectMgr->LoadGameTele();
+    });
 
-    LOG_INFO("server.loading", "Loading ArenaTeams...");
-    sArenaTeamMgr->LoadArenaTeams();
+    loaders.Add("Gossip Menu", []()
+    {
+        LOG_INFO("server.loading", "Loading Gossip Menu...");
+        sObjectMgr->LoadGossipMenu();
+    });
 
-    LOG_INFO("server.loading", "Loading Groups...");
-    sGroupMgr->LoadGroups();
+    loaders.Add("Gossip Menu Options", []()
+    {
+        LOG_INFO("server.loading", "Loading Gossip Menu Options...");
+        sObjectMgr->LoadGossipMenuItems();
+    }, { "Gossip Menu" });
 
-    LOG_INFO("server.loading", "Loading Reserved Names...");
-    sObjectMgr->LoadReservedPlayersNames();
+    loaders.Add("Vendors", []()
+    {
+        LOG_INFO("server.loading", "Loading Vendors...");
+        sObjectMgr->LoadVendors();                               // must be after load CreatureTemplate and ItemTemplate
+    });
 
-    LOG_INFO("server.loading", "Loading Profanity Names...");
-    sObjectMgr->LoadProfanityPlayersNames();
+    loaders.Add("Trainers", []()
+    {
+        LOG_INFO("server.loading", "Loading Trainers...");
+        sObjectMgr->LoadTrainerSpell();                          // must be after load CreatureTemplate
+    });
 
-    LOG_INFO("server.loading", "Loading GameObjects for Quests...");
-    sObjectMgr->LoadGameObjectForQuests();
+    loaders.Add("Waypoints", []()
+    {
+        LOG_INFO("server.loading", "Loading Waypoints...");
+        sWaypointMgr->Load();
+    });
 
-    LOG_INFO("server.loading", "Loading BattleMasters...");
-    sBattlegroundMgr->LoadBattleMastersEntry();
+    loaders.Add("SmartAI Waypoints", []()
+    {
+        LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
+        sSmartWaypointMgr->LoadFromDB();
+    });
 
-    LOG_INFO("server.loading", "Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
+    loaders.Add("Creature Formations", []()
+    {
+        LOG_INFO("server.loading", "Loading Creature Formations...");
+        sFormationMgr->LoadCreatureFormations();
+    });
 
-    LOG_INFO("server.loading", "Loading Gossip Menu...");
-    sObjectMgr->LoadGossipMenu();
+    uint32 loaderThreads = CONF_GET_UINT("World.Loading.Threads");
+    if (!loaderThreads)
+        loaderThreads = std::max(1u, std::thread::hardware_concurrency());
 
-    LOG_INFO("server.loading", "Loading Gossip Menu Options...");
-    sObjectMgr->LoadGossipMenuItems();
+    loaders.Run(loaderThreads);
 
-    LOG_INFO("server.loading", "Loading Vendors...");
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
+    ///- Load dynamic data tables from the database
+    LOG_INFO("server.loading", "Loading Item Auctions...");
+    sAuctionMgr->LoadAuctionItems();
 
-    LOG_INFO("server.loading", "Loading Trainers...");
-    sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
+    LOG_INFO("server", "Loading Auctions...");
+    sAuctionMgr->LoadAuctions();
 
-    LOG_INFO("server.loading", "Loading Waypoints...");
-    sWaypointMgr->Load();
+    sGuildMgr->LoadGuilds();
 
-    LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
+    LOG_INFO("server.loading", "Loading ArenaTeams...");
+    sArenaTeamMgr->LoadArenaTeams();
 
-    LOG_INFO("server.loading", "Loading Creature Formations...");
-    sFormationMgr->LoadCreatureFormations();
+    LOG_INFO("server.loading", "Loading Groups...");
+    sGroupMgr->LoadGroups();
+
+    LOG_INFO("server.loading", "Loading GameObjects for Quests...");
+    sObjectMgr->LoadGameObjectForQuests();                       // must be after loot tables
 
     LOG_INFO("server.loading", "Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
     LoadWorldStates();
@@ -1117,6 +1189,8 @@ void World::SetInitialWorldSettings()
 
     _mail_expire_check_timer = GameTime::GetGameTime() + 6h;
 
+    InitUpdateStages();
+
     ///- Initialize MapMgr
     LOG_INFO("server.loading", "Starting Map System");
     sMapMgr->Initialize();
@@ -1223,6 +1297,8 @@ void World::SetInitialWorldSettings()
     sAsyncAuctionMgr->Initialize();
     sAuctionBot->Initialize();
 
+    sDBCacheMgr->FinishSnapshot();
+
     auto elapsed = sw.Elapsed();
     std::string startupDuration = Warhead::Time::ToTimeString(elapsed, sw.GetOutCount());
 
@@ -1231,6 +1307,8 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server.loading", "World initialized in {}", startupDuration);
     LOG_INFO("server.loading", "");
 
+    loaders.LogTimings(10);
+
     METRIC_EVENT("events", "World initialized", "World initialized in " + startupDuration);
 
     sDiscordMgr->Start();
@@ -1295,7 +1373,7 @@ void World::Update(uint32 diff)
     // Record update if recording set in log and diff is greater then minimum set in log
     sWorldUpdateTime.RecordUpdateTime(getMSTime(), diff, GetActiveSessionCount());
 
-    DynamicVisibilityMgr::Update(GetActiveSessionCount());
+    DynamicVisibilityMgr::Update(GetActiveSessionCount(), sWorldUpdateTime.GetLastUpdateTime());
 
     ///- Update the different timers
     for (auto& _timer : _timers)
@@ -1306,16 +1384,6 @@ void World::Update(uint32 diff)
             _timer.SetCurrent(0);
     }
 
-    // pussywizard: our speed up and functionality
-    if (_timers[WUPDATE_5_SECS].Passed())
-    {
-        _timers[WUPDATE_5_SECS].Reset();
-
-        // moved here from HandleCharEnumOpcode
-        CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_EXPIRED_BANS);
-        CharacterDatabase.Execute(stmt);
-    }
-
     ///- Update Who List Cache
     if (_timers[WUPDATE_WHO_LIST].Passed())
     {
@@ -1420,9 +1488,21 @@ void World::Update(uint32 diff)
     }
 
     {
+        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update player save scheduler"));
+        sPlayerSaveScheduler->Update(diff);
+    }
+
+    {
+        bool pipelined = CONF_GET_BOOL("World.PipelinedUpdate") && sMapMgr->GetMapUpdater()->IsActive();
+        CollectUpdateStages(pipelined);
+
         ///- Update objects when the timer has passed (maps, transport, creatures, ...)
         METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update maps"));
-        sMapMgr->Update(diff);
+
+        if (pipelined && !_concurrentUpdateStages.empty())
+            sMapMgr->Update(diff, [this, diff]() { RunUpdateStages(_concurrentUpdateStages, diff); });
+        else
+            sMapMgr->Update(diff);
     }
 
     if (CONF_GET_BOOL("AutoBroadcast.On"))
@@ -1461,21 +1541,6 @@ void World::Update(uint32 diff)
         ProcessQueryCallbacks();
     }
 
-    /// <li> Update uptime table
-    if (_timers[WUPDATE_UPTIME].Passed())
-    {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update uptime"));
-
-        _timers[WUPDATE_UPTIME].Reset();
-
-        AuthDatabasePreparedStatement stmt = AuthDatabase.GetPreparedStatement(LOGIN_UPD_UPTIME_PLAYERS);
-        stmt->SetData(0, uint32(GameTime::GetUptime().count()));
-        stmt->SetData(1, uint16(GetMaxPlayerCount()));
-        stmt->SetData(2, realm.Id.Realm);
-        stmt->SetData(3, uint32(GameTime::GetStartTime().count()));
-        AuthDatabase.Execute(stmt);
-    }
-
     ///- Erase corpses once every 20 minutes
     if (_timers[WUPDATE_CORPSES].Passed())
     {
@@ -1530,19 +1595,92 @@ void World::Update(uint32 diff)
         sAsyncCallbackMgr->ProcessReadyCallbacks();
     }
 
+    // stages not already run during the map update
+    RunUpdateStages(_serialUpdateStages, diff);
+}
+
+void World::InitUpdateStages()
+{
+    _updateStages.clear();
+
+    // pussywizard: our speed up and functionality
+    _updateStages.push_back({ "Delete expired bans", WUPDATE_5_SECS, WORLD_RESOURCE_NONE, WORLD_RESOURCE_DATABASE, [](uint32 /*diff*/)
+    {
+        // moved here from HandleCharEnumOpcode
+        CharacterDatabasePreparedStatement stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_EXPIRED_BANS);
+        CharacterDatabase.Execute(stmt);
+    } });
+
+    /// <li> Update uptime table
+    _updateStages.push_back({ "Update uptime", WUPDATE_UPTIME, WORLD_RESOURCE_WORLD, WORLD_RESOURCE_DATABASE, [this](uint32 /*diff*/)
+    {
+        AuthDatabasePreparedStatement stmt = AuthDatabase.GetPreparedStatement(LOGIN_UPD_UPTIME_PLAYERS);
+        stmt->SetData(0, uint32(GameTime::GetUptime().count()));
+        stmt->SetData(1, uint16(GetMaxPlayerCount()));
+        stmt->SetData(2, realm.Id.Realm);
+        stmt->SetData(3, uint32(GameTime::GetStartTime().count()));
+        AuthDatabase.Execute(stmt);
+    } });
+
+    _updateStages.push_back({ "Update db mgr", WUPDATE_COUNT, WORLD_RESOURCE_NONE, WORLD_RESOURCE_DATABASE, [](uint32 diff)
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update db mgr"));
         sDatabaseMgr->Update(Milliseconds{ diff });
-    }
+    } });
 
+    // Stats logger update, overall status reads player count and db queue sizes
+    _updateStages.push_back({ "Update metrics", WUPDATE_COUNT, WORLD_RESOURCE_WORLD | WORLD_RESOURCE_DATABASE, WORLD_RESOURCE_METRICS, [](uint32 diff)
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update metrics"));
-        // Stats logger update
         sMetric->Update();
         METRIC_VALUE("update_time_diff", diff);
+    } });
+}
+
+/*static*/ bool World::CanRunWithMapUpdate(UpdateStage const& stage)
+{
+    // map threads own everything an object update can reach and only read world wide state
+    constexpr uint32 mapUpdateWrites = WORLD_RESOURCE_MAPS | WORLD_RESOURCE_PLAYERS | WORLD_RESOURCE_SESSIONS | WORLD_RESOURCE_GROUPS;
+    constexpr uint32 mapUpdateReads = mapUpdateWrites | WORLD_RESOURCE_WORLD;
+
+    uint32 reads = stage.Reads & ~WORLD_RESOURCE_THREAD_SAFE;
+    uint32 writes = stage.Writes & ~WORLD_RESOURCE_THREAD_SAFE;
+
+    return !(reads & mapUpdateWrites) && !(writes & mapUpdateReads);
+}
+
+void World::CollectUpdateStages(bool pipelined)
+{
+    _concurrentUpdateStages.clear();
+    _serialUpdateStages.clear();
+
+    for (UpdateStage const& stage : _updateStages)
+    {
+        // timers are only touched by the world thread
+        if (stage.Timer != WUPDATE_COUNT)
+        {
+            if (!_timers[stage.Timer].Passed())
+                continue;
+
+            _timers[stage.Timer].Reset();
+        }
+
+        if (pipelined && CanRunWithMapUpdate(stage))
+            _concurrentUpdateStages.emplace_back(&stage);
+        else
+            _serialUpdateStages.emplace_back(&stage);
     }
 }
 
+void World::RunUpdateStages(std::vector<UpdateStage const*>& stages, uint32 diff)
+{
+    for (UpdateStage const* stage : stages)
+    {
+        METRIC_TIMER("world_update_time", METRIC_TAG("type", stage->Name));
+        stage->Update(diff);
+    }
+
+    stages.clear();
+}
+
 void World::ForceGameEventUpdate()
 {
     _timers[WUPDATE_EVENTS].Reset();                   // to give time for Update() to be processed
@@ -1554,6 +1692,7 @@ void World::ForceGameEventUpdate()
 /// Send a packet to all players (except self if mentioned)
 void World::SendGlobalMessage(WorldPacket const* packet, WorldSession* self, TeamId teamId)
 {
+    SharedWorldPacket sharedPacket(*packet);
     SessionMap::const_iterator itr;
     for (itr = _sessions.begin(); itr != _sessions.end(); ++itr)
     {
@@ -1563,7 +1702,7 @@ void World::SendGlobalMessage(WorldPacket const* packet, WorldSession* self, Tea
                 itr->second != self &&
                 (teamId == TEAM_NEUTRAL || itr->second->GetPlayer()->GetTeamId() == teamId))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(sharedPacket);
         }
     }
 }
@@ -1571,6 +1710,7 @@ void World::SendGlobalMessage(WorldPacket const* packet, WorldSession* self, Tea
 /// Send a packet to all GMs (except self if mentioned)
 void World::SendGlobalGMMessage(WorldPacket const* packet, WorldSession* self, TeamId teamId)
 {
+    SharedWorldPacket sharedPacket(*packet);
     SessionMap::iterator itr;
     for (itr = _sessions.begin(); itr != _sessions.end(); ++itr)
     {
@@ -1581,7 +1721,7 @@ void World::SendGlobalGMMessage(WorldPacket const* packet, WorldSession* self, T
                 !AccountMgr::IsPlayerAccount(itr->second->GetSecurity()) &&
                 (teamId == TEAM_NEUTRAL || itr->second->GetPlayer()->GetTeamId() == teamId))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(sharedPacket);
         }
     }
 }
@@ -1602,6 +1742,7 @@ void World::SendGlobalText(std::string_view text, WorldSession* self)
 bool World::SendZoneMessage(uint32 zone, WorldPacket const* packet, WorldSession* self, TeamId teamId)
 {
     bool foundPlayerToSend = false;
+    SharedWorldPacket sharedPacket(*packet);
     SessionMap::const_iterator itr;
 
     for (itr = _sessions.begin(); itr != _sessions.end(); ++itr)
@@ -1613,7 +1754,7 @@ bool World::SendZoneMessage(uint32 zone, WorldPacket const* packet, WorldSession
                 itr->second != self &&
                 (teamId == TEAM_NEUTRAL || itr->second->GetPlayer()->GetTeamId() == teamId))
         {
-            itr->second->SendPacket(packet);
+            itr->second->SendPacket(sharedPacket);
             foundPlayerToSend = true;
         }
     }
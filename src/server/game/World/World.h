@@ -30,9 +30,11 @@
 #include "SharedDefines.h"
 #include "Timer.h"
 #include <atomic>
+#include <functional>
 #include <list>
 #include <map>
 #include <unordered_map>
+#include <vector>
 
 class Object;
 class WorldPacket;
@@ -100,6 +102,21 @@ enum WorldTimers
     WUPDATE_COUNT
 };
 
+/// State shared by World::Update stages, decides which stages may overlap the map update
+enum WorldUpdateResource : uint32
+{
+    WORLD_RESOURCE_NONE     = 0x00,
+    WORLD_RESOURCE_MAPS     = 0x01, // maps, grids and objects in them
+    WORLD_RESOURCE_PLAYERS  = 0x02, // player objects, also outside of maps
+    WORLD_RESOURCE_SESSIONS = 0x04, // world sessions and their packet queues
+    WORLD_RESOURCE_GROUPS   = 0x08, // groups, lfg and battleground queues
+    WORLD_RESOURCE_WORLD    = 0x10, // world timers, counters and states
+    WORLD_RESOURCE_DATABASE = 0x20, // async database queues and pools, thread safe
+    WORLD_RESOURCE_METRICS  = 0x40, // metric queue, thread safe
+
+    WORLD_RESOURCE_THREAD_SAFE = WORLD_RESOURCE_DATABASE | WORLD_RESOURCE_METRICS
+};
+
 /// Can be used in SMSG_AUTH_RESPONSE packet
 enum BillingPlanFlags
 {
@@ -404,6 +421,25 @@ private:
     void ProcessQueryCallbacks();
     QueryCallbackProcessor _queryProcessor;
 
+    // tail of World::Update, stages with declared access are run while maps update when nothing conflicts
+    struct UpdateStage
+    {
+        std::string Name;
+        WorldTimers Timer; // WUPDATE_COUNT - every tick
+        uint32 Reads;
+        uint32 Writes;
+        std::function<void(uint32 diff)> Update;
+    };
+
+    void InitUpdateStages();
+    void CollectUpdateStages(bool pipelined);
+    void RunUpdateStages(std::vector<UpdateStage const*>& stages, uint32 diff);
+    [[nodiscard]] static bool CanRunWithMapUpdate(UpdateStage const& stage);
+
+    std::vector<UpdateStage> _updateStages;
+    std::vector<UpdateStage const*> _concurrentUpdateStages;
+    std::vector<UpdateStage const*> _serialUpdateStages;
+
     World();
     ~World();
     World(World const&) = delete;
@@ -130,23 +130,23 @@ public:
                         // Cast Hateful strike on the player with the highest amount of HP within melee distance, and second threat amount
                         std::list<Unit*> meleeRangeTargets;
                         Unit* finalTarget = nullptr;
-                        uint8 counter = 0;
-                        auto i = me->GetThreatMgr().GetThreatList().begin();
-                        for (; i != me->GetThreatMgr().GetThreatList().end(); ++i, ++counter)
+                        // by index, adding threat to a pet adds its owner to the threat list
+                        ThreatContainer::StorageType const& threatList = me->GetThreatMgr().GetThreatList();
+                        for (std::size_t i = 0; i < threatList.size(); ++i)
                         {
                             // Gather all units with melee range
-                            Unit* target = (*i)->getTarget();
+                            Unit* target = threatList[i]->getTarget();
                             if (me->IsWithinMeleeRange(target))
                             {
                                 meleeRangeTargets.push_back(target);
                             }
                             // and add threat to most hated
-                            if (counter < RAID_MODE(2, 3))
+                            if (i < RAID_MODE<std::size_t>(2, 3))
                             {
                                 me->AddThreat(target, 500.0f);
                             }
                         }
-                        counter = 0;
+                        uint8 counter = 0;
                         std::list<Unit*, std::allocator<Unit*>>::iterator itr;
                         for (itr = meleeRangeTargets.begin(); itr != meleeRangeTargets.end(); ++itr, ++counter)
                         {
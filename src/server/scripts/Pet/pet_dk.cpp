@@ -183,6 +183,7 @@ public:
                 std::list<Unit*> targets;
                 Warhead::AnyUnfriendlyUnitInObjectRangeCheck u_check(me, me, 50.0f);
                 Warhead::UnitListSearcher<Warhead::AnyUnfriendlyUnitInObjectRangeCheck> searcher(me, targets, u_check);
+                searcher.i_searchArea.Set(me, 50.0f);
                 Cell::VisitAllObjects(me, searcher, 50.0f);
                 for (std::list<Unit*>::const_iterator iter = targets.begin(); iter != targets.end(); ++iter)
                     if ((*iter)->GetAura(SPELL_DK_SUMMON_GARGOYLE_1, me->GetOwnerGUID()))
@@ -0,0 +1,367 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+#include "DBCCache.h"
+#include "DBCFileLoader.h"
+#include "Util.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#if WARHEAD_PLATFORM != WARHEAD_PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr uint32 CACHE_MAGIC = 0x43434257;          // 'WBCC'
+    constexpr uint32 CACHE_VERSION = 1;
+    constexpr uint64 HASH_PRIME = 1099511628211ULL;
+    constexpr std::size_t HASH_CHUNK = 1 << 16;
+
+    struct DBCCacheHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        uint64 SourceHash;
+        uint64 FormatHash;
+        uint32 FieldCount;
+        uint32 RecordSize;
+        uint32 RecordCount;
+        uint32 IndexTableSize;
+        uint32 LocaleMask;
+        uint32 StringBlockSize;
+        uint64 DataOffset;
+        uint64 StringOffset;
+    };
+
+    static_assert(sizeof(DBCCacheHeader) == 64);
+
+    inline uint64 Mix(uint64 hash, uint64 value)
+    {
+        return (hash ^ value) * HASH_PRIME;
+    }
+
+    uint64 GetFormatHash(char const* format)
+    {
+        uint64 hash = Mix(DBCCacheFile::HASH_SEED, CACHE_VERSION);
+        hash = Mix(hash, sizeof(char*));
+        for (char const* c = format; *c; ++c)
+            hash = Mix(hash, uint8(*c));
+
+        return hash;
+    }
+
+    // Offsets of the char* fields inside a record, same walk as DBCFileLoader::AutoProduceStrings
+    std::vector<uint32> GetStringFieldOffsets(char const* format)
+    {
+        std::vector<uint32> offsets;
+        uint32 offset = 0;
+
+        for (char const* c = format; *c; ++c)
+        {
+            switch (*c)
+            {
+                case FT_FLOAT:
+                    offset += sizeof(float);
+                    break;
+                case FT_IND:
+                case FT_INT:
+                    offset += sizeof(uint32);
+                    break;
+                case FT_BYTE:
+                    offset += sizeof(uint8);
+                    break;
+                case FT_STRING:
+                    offsets.push_back(offset);
+                    offset += sizeof(char*);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        return offsets;
+    }
+
+    inline uint64 AlignOffset(uint64 offset)
+    {
+        return (offset + 15) & ~uint64(15);
+    }
+}
+
+DBCCacheFile::DBCCacheFile() : _data(nullptr), _size(0)
+{
+}
+
+DBCCacheFile::~DBCCacheFile()
+{
+#if WARHEAD_PLATFORM != WARHEAD_PLATFORM_WINDOWS
+    if (_data && !_buffer)
+        munmap(_data, _size);
+#endif
+}
+
+uint64 DBCCacheFile::HashFile(char const* path, uint64 hash)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f)
+        return Mix(hash, 0);
+
+    // hashed a word at a time, the files are read on every startup
+    std::unique_ptr<uint64[]> buffer = std::make_unique<uint64[]>(HASH_CHUNK / sizeof(uint64));
+    uint8 const* bytes = reinterpret_cast<uint8 const*>(buffer.get());
+    uint64 fileSize = 0;
+
+    while (std::size_t read = fread(buffer.get(), 1, HASH_CHUNK, f))
+    {
+        std::size_t words = read / sizeof(uint64);
+        for (std::size_t i = 0; i < words; ++i)
+            hash = Mix(hash, buffer[i]);
+
+        for (std::size_t i = words * sizeof(uint64); i < read; ++i)
+            hash = Mix(hash, bytes[i]);
+
+        fileSize += read;
+    }
+
+    fclose(f);
+    return Mix(hash, fileSize + 1);
+}
+
+bool DBCCacheFile::Map(char const* path)
+{
+#if WARHEAD_PLATFORM != WARHEAD_PLATFORM_WINDOWS
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < off_t(sizeof(DBCCacheHeader)))
+    {
+        close(fd);
+        return false;
+    }
+
+    // private writable mapping: pages are shared until the string fields get patched
+    void* data = mmap(nullptr, std::size_t(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    _data = static_cast<char*>(data);
+    _size = std::size_t(st.st_size);
+    return true;
+#else
+    FILE* f = fopen(path, "rb");
+    if (!f)
+        return false;
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    if (size < long(sizeof(DBCCacheHeader)))
+    {
+        fclose(f);
+        return false;
+    }
+
+    _buffer = std::make_unique<char[]>(std::size_t(size));
+    if (fread(_buffer.get(), std::size_t(size), 1, f) != 1)
+    {
+        fclose(f);
+        _buffer.reset();
+        return false;
+    }
+
+    fclose(f);
+    _data = _buffer.get();
+    _size = std::size_t(size);
+    return true;
+#endif
+}
+
+bool DBCCacheFile::Load(char const* path, char const* format, uint64 sourceHash, uint32& fieldCount, uint32& localeMask, uint32& indexTableSize, char**& indexTable)
+{
+    if (_data || !Map(path))
+        return false;
+
+    DBCCacheHeader header;
+    memcpy(&header, _data, sizeof(header));
+
+    if (header.Magic != CACHE_MAGIC || header.Version != CACHE_VERSION || header.SourceHash != sourceHash || header.FormatHash != GetFormatHash(format))
+        return false;
+
+    if (header.RecordSize != DBCFileLoader::GetFormatRecordSize(format) || header.FieldCount != strlen(format))
+        return false;
+
+    uint64 indexEnd = sizeof(DBCCacheHeader) + uint64(header.IndexTableSize) * sizeof(uint32);
+    if (header.DataOffset < indexEnd || header.StringOffset != header.DataOffset + uint64(header.RecordCount) * header.RecordSize ||
+        header.StringOffset + header.StringBlockSize != _size)
+        return false;
+
+    char* records = _data + header.DataOffset;
+    char* strings = _data + header.StringOffset;
+
+    // patch string offsets into pointers
+    std::vector<uint32> stringFields = GetStringFieldOffsets(format);
+    if (!stringFields.empty())
+    {
+        for (uint32 i = 0; i < header.RecordCount; ++i)
+        {
+            char* record = records + std::size_t(i) * header.RecordSize;
+            for (uint32 fieldOffset : stringFields)
+            {
+                uintptr_t value;
+                memcpy(&value, record + fieldOffset, sizeof(value));
+
+                char* str = nullptr;
+                if (value)
+                {
+                    if (value > header.StringBlockSize)
+                        return false;
+
+                    str = strings + value - 1;
+                }
+
+                memcpy(record + fieldOffset, &str, sizeof(str));
+            }
+        }
+    }
+
+    uint32 const* index = reinterpret_cast<uint32 const*>(_data + sizeof(DBCCacheHeader));
+    std::unique_ptr<char*[]> table = std::make_unique<char*[]>(header.IndexTableSize);
+
+    for (uint32 i = 0; i < header.IndexTableSize; ++i)
+    {
+        if (!index[i])
+            continue;
+
+        if (index[i] > header.RecordCount)
+            return false;
+
+        table[i] = records + std::size_t(index[i] - 1) * header.RecordSize;
+    }
+
+    fieldCount = header.FieldCount;
+    localeMask = header.LocaleMask;
+    indexTableSize = header.IndexTableSize;
+    indexTable = table.release();
+    return true;
+}
+
+bool DBCCacheFile::Save(char const* path, char const* format, uint64 sourceHash, uint32 fieldCount, uint32 localeMask,
+    char const* dataTable, uint32 recordCount, uint32 indexTableSize, char* const* indexTable)
+{
+    uint32 recordSize = DBCFileLoader::GetFormatRecordSize(format);
+    std::size_t dataSize = std::size_t(recordCount) * recordSize;
+
+    std::vector<uint32> index(indexTableSize, 0);
+    for (uint32 i = 0; i < indexTableSize; ++i)
+    {
+        if (!indexTable[i])
+            continue;
+
+        // only records of the file itself can be cached
+        if (indexTable[i] < dataTable || indexTable[i] >= dataTable + dataSize)
+            return false;
+
+        index[i] = uint32((indexTable[i] - dataTable) / recordSize) + 1;
+    }
+
+    std::vector<char> records(dataTable, dataTable + dataSize);
+    std::string strings;
+    std::unordered_map<std::string_view, uintptr_t> interned;
+
+    std::vector<uint32> stringFields = GetStringFieldOffsets(format);
+    for (uint32 i = 0; i < recordCount && !stringFields.empty(); ++i)
+    {
+        char* record = records.data() + std::size_t(i) * recordSize;
+        for (uint32 fieldOffset : stringFields)
+        {
+            char const* str;
+            memcpy(&str, record + fieldOffset, sizeof(str));
+
+            uintptr_t value = 0;
+            if (str)
+            {
+                auto [itr, inserted] = interned.try_emplace(std::string_view(str), strings.size() + 1);
+                if (inserted)
+                    strings.append(str, strlen(str) + 1);
+
+                value = itr->second;
+            }
+
+            memcpy(record + fieldOffset, &value, sizeof(value));
+        }
+    }
+
+    DBCCacheHeader header;
+    header.Magic = CACHE_MAGIC;
+    header.Version = CACHE_VERSION;
+    header.SourceHash = sourceHash;
+    header.FormatHash = GetFormatHash(format);
+    header.FieldCount = fieldCount;
+    header.RecordSize = recordSize;
+    header.RecordCount = recordCount;
+    header.IndexTableSize = indexTableSize;
+    header.LocaleMask = localeMask;
+    header.StringBlockSize = uint32(strings.size());
+    header.DataOffset = AlignOffset(sizeof(DBCCacheHeader) + uint64(indexTableSize) * sizeof(uint32));
+    header.StringOffset = header.DataOffset + dataSize;
+
+    // written aside and renamed, other processes may be mapping the old file or writing their own copy
+    std::string tmpPath = std::string(path) + "." + std::to_string(GetPID()) + ".tmp";
+    FILE* f = fopen(tmpPath.c_str(), "wb");
+    if (!f)
+        return false;
+
+    static char const padding[16] = { };
+    std::size_t paddingSize = std::size_t(header.DataOffset - sizeof(DBCCacheHeader) - uint64(indexTableSize) * sizeof(uint32));
+
+    bool written = fwrite(&header, sizeof(header), 1, f) == 1
+        && (index.empty() || fwrite(index.data(), index.size() * sizeof(uint32), 1, f) == 1)
+        && (!paddingSize || fwrite(padding, paddingSize, 1, f) == 1)
+        && (records.empty() || fwrite(records.data(), records.size(), 1, f) == 1)
+        && (strings.empty() || fwrite(strings.data(), strings.size(), 1, f) == 1);
+
+    written = (fclose(f) == 0) && written;
+
+    std::error_code error;
+    if (written)
+        std::filesystem::rename(tmpPath, path, error);
+
+    if (!written || error)
+    {
+        std::filesystem::remove(tmpPath, error);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,59 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DBCCACHE_H
+#define DBCCACHE_H
+
+#include "Define.h"
+#include <memory>
+
+/*
+  Pre-indexed binary image of a dbc store after its file and locale strings were loaded.
+  Layout: header, index table (record number + 1 per id, 0 - no record), records in their
+  in-memory layout with string fields stored as offsets, interned string block.
+  The file is mapped copy-on-write: string fields are patched into pointers once at load, every
+  other page stays shared with all processes mapping the same cache.
+*/
+class WH_SHARED_API DBCCacheFile
+{
+public:
+    static constexpr uint64 HASH_SEED = 14695981039346656037ULL;
+
+    DBCCacheFile();
+    ~DBCCacheFile();
+
+    // Mixes the content of the file (or its absence) into hash
+    static uint64 HashFile(char const* path, uint64 hash);
+
+    // Maps the cache, fails if it was built from other source files or for another format
+    bool Load(char const* path, char const* format, uint64 sourceHash, uint32& fieldCount, uint32& localeMask, uint32& indexTableSize, char**& indexTable);
+
+    static bool Save(char const* path, char const* format, uint64 sourceHash, uint32 fieldCount, uint32 localeMask,
+        char const* dataTable, uint32 recordCount, uint32 indexTableSize, char* const* indexTable);
+
+private:
+    bool Map(char const* path);
+
+    char* _data;
+    std::size_t _size;
+    std::unique_ptr<char[]> _buffer;    // used instead of a mapping where mmap is not available
+
+    DBCCacheFile(DBCCacheFile const& right) = delete;
+    DBCCacheFile& operator=(DBCCacheFile const& right) = delete;
+};
+
+#endif
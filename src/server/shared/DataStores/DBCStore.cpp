@@ -16,9 +16,10 @@
  */
 
 #include "DBCStore.h"
+#include "DBCCache.h"
 #include "DBCDatabaseLoader.h"
 
-DBCStorageBase::DBCStorageBase(char const* fmt) : _fieldCount(0), _fileFormat(fmt), _dataTable(nullptr), _indexTableSize(0)
+DBCStorageBase::DBCStorageBase(char const* fmt) : _fieldCount(0), _fileFormat(fmt), _dataTable(nullptr), _indexTableSize(0), _recordCount(0)
 {
 }
 
@@ -40,6 +41,7 @@ bool DBCStorageBase::Load(char const* path, char**& indexTable)
         return false;
 
     _fieldCount = dbc.GetCols();
+    _recordCount = dbc.GetNumRows();
 
     // load raw non-string data
     _dataTable = dbc.AutoProduceData(_fileFormat, _indexTableSize, indexTable);
@@ -75,3 +77,25 @@ void DBCStorageBase::LoadFromDB(char const* table, char const* format, char**& i
 {
     _stringPool.push_back(DBCDatabaseLoader(table, format, _stringPool).Load(_indexTableSize, indexTable));
 }
+
+bool DBCStorageBase::LoadFromCache(char const* path, uint64 sourceHash, uint32& localeMask, char**& indexTable)
+{
+    // must be the first load of the storage
+    if (indexTable)
+        return false;
+
+    auto cacheFile = std::make_unique<DBCCacheFile>();
+    if (!cacheFile->Load(path, _fileFormat, sourceHash, _fieldCount, localeMask, _indexTableSize, indexTable))
+        return false;
+
+    _cacheFile = std::move(cacheFile);
+    return true;
+}
+
+bool DBCStorageBase::SaveToCache(char const* path, uint64 sourceHash, uint32 localeMask, char* const* indexTable) const
+{
+    if (!indexTable || !_dataTable)
+        return false;
+
+    return DBCCacheFile::Save(path, _fileFormat, sourceHash, _fieldCount, localeMask, _dataTable, _recordCount, _indexTableSize, indexTable);
+}
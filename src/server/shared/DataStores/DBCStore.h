@@ -21,8 +21,11 @@
 #include "DBCStorageIterator.h"
 #include "Errors.h"
 #include <cstring>
+#include <memory>
 #include <vector>
 
+class DBCCacheFile;
+
 /// Interface class for common access
 class WH_SHARED_API DBCStorageBase
 {
@@ -36,17 +39,23 @@ public:
     virtual bool Load(char const* path) = 0;
     virtual bool LoadStringsFrom(char const* path) = 0;
     virtual void LoadFromDB(char const* table, char const* format) = 0;
+    virtual bool LoadFromCache(char const* path, uint64 sourceHash, uint32& localeMask) = 0;
+    virtual bool SaveToCache(char const* path, uint64 sourceHash, uint32 localeMask) const = 0;
 
 protected:
     bool Load(char const* path, char**& indexTable);
     bool LoadStringsFrom(char const* path, char** indexTable);
     void LoadFromDB(char const* table, char const* format, char**& indexTable);
+    bool LoadFromCache(char const* path, uint64 sourceHash, uint32& localeMask, char**& indexTable);
+    bool SaveToCache(char const* path, uint64 sourceHash, uint32 localeMask, char* const* indexTable) const;
 
     uint32 _fieldCount;
     char const* _fileFormat;
     char* _dataTable;
     std::vector<char*> _stringPool;
     uint32 _indexTableSize;
+    uint32 _recordCount;                        // records of _dataTable
+    std::unique_ptr<DBCCacheFile> _cacheFile;   // holds the records instead of _dataTable when loaded from cache
 };
 
 template <class T>
@@ -104,6 +113,16 @@ public:
         DBCStorageBase::LoadFromDB(table, format, _indexTable.AsChar);
     }
 
+    bool LoadFromCache(char const* path, uint64 sourceHash, uint32& localeMask) override
+    {
+        return DBCStorageBase::LoadFromCache(path, sourceHash, localeMask, _indexTable.AsChar);
+    }
+
+    bool SaveToCache(char const* path, uint64 sourceHash, uint32 localeMask) const override
+    {
+        return DBCStorageBase::SaveToCache(path, sourceHash, localeMask, _indexTable.AsChar);
+    }
+
     iterator begin() { return iterator(_indexTable.AsT, _indexTableSize); }
     iterator end() { return iterator(_indexTable.AsT, _indexTableSize, _indexTableSize); }
 
@@ -22,14 +22,16 @@
 #include "MessageBuffer.h"
 #include <atomic>
 #include <boost/asio/ip/tcp.hpp>
+#include <deque>
 #include <functional>
 #include <memory>
-#include <queue>
 #include <type_traits>
+#include <vector>
 
 using boost::asio::ip::tcp;
 
 #define READ_BLOCK_SIZE 4096
+#define WRITE_GATHER_BUFFERS 64 // queued buffers sent with a single (scatter/gather) write
 #ifdef BOOST_ASIO_HAS_IOCP
 #define WH_SOCKET_USE_IOCP
 #endif
@@ -42,6 +44,7 @@ public:
         _remotePort(_socket.remote_endpoint().port()), _readBuffer(), _closed(false), _closing(false), _isWritingAsync(false)
     {
         _readBuffer.Resize(READ_BLOCK_SIZE);
+        _writeBuffers.reserve(WRITE_GATHER_BUFFERS);
     }
 
     virtual ~Socket()
@@ -103,7 +106,7 @@ public:
 
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueue.push_back(std::move(buffer));
 
 #ifdef WH_SOCKET_USE_IOCP
         AsyncProcessQueue();
@@ -144,8 +147,8 @@ protected:
         _isWritingAsync = true;
 
 #ifdef WH_SOCKET_USE_IOCP
-        MessageBuffer& buffer = _writeQueue.front();
-        _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()), std::bind(&Socket<T>::WriteHandler,
+        GatherWriteBuffers();
+        _socket.async_write_some(_writeBuffers, std::bind(&Socket<T>::WriteHandler,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
 #else
         _socket.async_write_some(boost::asio::null_buffers(), std::bind(&Socket<T>::WriteHandlerWrapper,
@@ -178,6 +181,41 @@ private:
         ReadHandler();
     }
 
+    /// collects the front of the write queue into one buffer sequence, returns its size in bytes
+    std::size_t GatherWriteBuffers()
+    {
+        _writeBuffers.clear();
+
+        std::size_t bytes = 0;
+        for (MessageBuffer& buffer : _writeQueue)
+        {
+            if (_writeBuffers.size() >= WRITE_GATHER_BUFFERS)
+                break;
+
+            _writeBuffers.emplace_back(buffer.GetReadPointer(), buffer.GetActiveSize());
+            bytes += buffer.GetActiveSize();
+        }
+
+        return bytes;
+    }
+
+    /// drops fully written buffers, the first partially written one keeps its unsent rest
+    void ConsumeWrittenBytes(std::size_t bytes)
+    {
+        while (bytes && !_writeQueue.empty())
+        {
+            MessageBuffer& buffer = _writeQueue.front();
+            if (bytes < buffer.GetActiveSize())
+            {
+                buffer.ReadCompleted(bytes);
+                return;
+            }
+
+            bytes -= buffer.GetActiveSize();
+            _writeQueue.pop_front();
+        }
+    }
+
 #ifdef WH_SOCKET_USE_IOCP
 
     void WriteHandler(boost::system::error_code error, std::size_t transferedBytes)
@@ -185,10 +223,7 @@ private:
         if (!error)
         {
             _isWritingAsync = false;
-            _writeQueue.front().ReadCompleted(transferedBytes);
-
-            if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+            ConsumeWrittenBytes(transferedBytes);
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
@@ -212,19 +247,17 @@ private:
         if (_writeQueue.empty())
             return false;
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        std::size_t bytesToSend = GatherWriteBuffers();
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        std::size_t bytesSent = _socket.write_some(_writeBuffers, error);
 
         if (error)
         {
             if (error == boost::asio::error::would_block || error == boost::asio::error::try_again)
                 return AsyncProcessQueue();
 
-            _writeQueue.pop();
+            _writeQueue.pop_front();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
 
@@ -232,19 +265,18 @@ private:
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
+            _writeQueue.pop_front();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
 
             return false;
         }
-        else if (bytesSent < bytesToSend) // now n > 0
-        {
-            queuedMessage.ReadCompleted(bytesSent);
+
+        ConsumeWrittenBytes(bytesSent);
+
+        if (bytesSent < bytesToSend) // now n > 0
             return AsyncProcessQueue();
-        }
 
-        _writeQueue.pop();
         if (_closing && _writeQueue.empty())
             CloseSocket();
 
@@ -259,7 +291,8 @@ private:
     uint16 _remotePort;
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<MessageBuffer> _writeQueue;
+    std::vector<boost::asio::const_buffer> _writeBuffers;
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
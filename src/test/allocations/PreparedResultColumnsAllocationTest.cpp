@@ -0,0 +1,111 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Own executable: the operator new below replaces the global one of the whole binary
+
+#include "PreparedResultColumnsData.h"
+#include "gtest/gtest.h"
+#include <cstdlib>
+#include <new>
+#include <string>
+
+using namespace PreparedResultColumnsData;
+
+namespace
+{
+    thread_local bool CountAllocations = false;
+    thread_local uint64 Allocations = 0;
+    thread_local uint64 AllocatedBytes = 0;
+
+    struct AllocationCounter
+    {
+        AllocationCounter()
+        {
+            Allocations = 0;
+            AllocatedBytes = 0;
+            CountAllocations = true;
+        }
+
+        ~AllocationCounter() { CountAllocations = false; }
+    };
+}
+
+void* operator new(std::size_t size)
+{
+    if (CountAllocations)
+    {
+        ++Allocations;
+        AllocatedBytes += size;
+    }
+
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+TEST(PreparedResultColumnsAllocationTest, AllocationsFor100kRows)
+{
+    constexpr uint64 rowCount = 100000;
+    std::vector<QueryResultFieldMetadata> metadata = MakeMetadata();
+    PreparedResultColumns columns;
+    Field fields[COLUMN_COUNT];
+    uint64 checksum = 0;
+
+    {
+        AllocationCounter counter;
+
+        columns.Allocate(SLOT_SIZES, COLUMN_COUNT, rowCount);
+
+        for (uint64 row = 0; row < rowCount; ++row)
+            FillRow(columns, row);
+
+        columns.InitializeRow(fields, metadata.data());
+
+        for (uint64 row = 0; row < rowCount; ++row)
+        {
+            columns.ReadRow(row, fields);
+            checksum += fields[0].Get<uint32>() + fields[1].Get<std::string_view>().size() + fields[6].Get<uint8>();
+        }
+    }
+
+    uint64 expectedChecksum = 0;
+    for (uint64 row = 0; row < rowCount; ++row)
+        expectedChecksum += (row + 1) + ("Char" + std::to_string(row + 1)).size() + row % 60;
+
+    // a Field per value, as results were buffered before
+    uint64 perValueBytes = rowCount * COLUMN_COUNT * sizeof(Field);
+
+    RecordProperty("Allocations", std::to_string(Allocations));
+    RecordProperty("AllocatedBytes", std::to_string(AllocatedBytes));
+    RecordProperty("FieldObjectBytes", std::to_string(perValueBytes));
+
+    EXPECT_EQ(checksum, expectedChecksum);
+    EXPECT_EQ(Allocations, 1u);
+    EXPECT_EQ(AllocatedBytes, columns.GetAllocatedSize());
+    EXPECT_LT(AllocatedBytes, perValueBytes);
+}
@@ -0,0 +1,310 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EventMap.h"
+#include "gtest/gtest.h"
+
+#include <map>
+#include <random>
+#include <vector>
+
+namespace
+{
+    /// EventMap as it was implemented on top of a std::multimap, the reference for the event order
+    class ReferenceEventMap
+    {
+    public:
+        void Reset()
+        {
+            _eventMap.clear();
+            _time = 0;
+            _phase = 0;
+        }
+
+        void Update(uint32 time) { _time += time; }
+
+        void SetPhase(uint8 phase) { _phase = phase ? (1 << (phase - 1)) : 0; }
+
+        void ScheduleEvent(uint32 eventId, uint32 time, uint32 group, uint32 phase)
+        {
+            if (group && group <= 8)
+                eventId |= (1 << (group + 15));
+
+            if (phase && phase <= 8)
+                eventId |= (1 << (phase + 23));
+
+            _eventMap.emplace(_time + time, eventId);
+        }
+
+        void RescheduleEvent(uint32 eventId, uint32 time, uint32 group, uint32 phase)
+        {
+            CancelEvent(eventId);
+            ScheduleEvent(eventId, time, group, phase);
+        }
+
+        void RepeatEvent(uint32 time) { _eventMap.emplace(_time + time, _lastEvent); }
+
+        uint32 ExecuteEvent()
+        {
+            while (!_eventMap.empty())
+            {
+                auto itr = _eventMap.begin();
+                if (itr->first > _time)
+                    return 0;
+
+                uint32 data = itr->second;
+                _eventMap.erase(itr);
+
+                if (!_phase || !(data & 0xFF000000) || ((data >> 24) & _phase))
+                {
+                    _lastEvent = data;
+                    return data & 0x0000FFFF;
+                }
+            }
+
+            return 0;
+        }
+
+        void DelayEvents(uint32 delay) { _time = delay < _time ? _time - delay : 0; }
+
+        void DelayEvents(uint32 delay, uint32 group)
+        {
+            if (group > 8)
+                return;
+
+            std::multimap<uint32, uint32> delayed;
+            for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
+            {
+                if (!group || (itr->second & (1 << (group + 15))))
+                {
+                    delayed.emplace(itr->first + delay, itr->second);
+                    itr = _eventMap.erase(itr);
+                    continue;
+                }
+
+                ++itr;
+            }
+
+            _eventMap.insert(delayed.begin(), delayed.end());
+        }
+
+        void DelayEventsToMax(uint32 delay, uint32 group)
+        {
+            for (auto itr = _eventMap.begin(); itr != _eventMap.end();)
+            {
+                if (itr->first < _time + delay && (group == 0 || ((1 << (group + 15)) & itr->second)))
+                {
+                    _eventMap.emplace(_time + delay, itr->second);
+                    _eventMap.erase(itr);
+                    itr = _eventMap.begin();
+                    continue;
+                }
+
+                ++itr;
+            }
+        }
+
+        void CancelEvent(uint32 eventId)
+        {
+            std::erase_if(_eventMap, [eventId](auto const& event) { return eventId == (event.second & 0x0000FFFF); });
+        }
+
+        void CancelEventGroup(uint32 group)
+        {
+            if (!group || group > 8)
+                return;
+
+            std::erase_if(_eventMap, [group](auto const& event) { return event.second & (1 << (group + 15)); });
+        }
+
+        uint32 GetNextEventTime(uint32 eventId) const
+        {
+            for (auto const& event : _eventMap)
+                if (eventId == (event.second & 0x0000FFFF))
+                    return event.first;
+
+            return 0;
+        }
+
+        uint32 GetNextEventTime() const { return _eventMap.empty() ? 0 : _eventMap.begin()->first; }
+
+    private:
+        uint32 _time{ 0 };
+        uint32 _phase{ 0 };
+        uint32 _lastEvent{ 0 };
+        std::multimap<uint32, uint32> _eventMap;
+    };
+
+    std::vector<uint32> ExecuteAll(EventMap& events)
+    {
+        std::vector<uint32> executed;
+        while (uint32 eventId = events.ExecuteEvent())
+            executed.push_back(eventId);
+
+        return executed;
+    }
+}
+
+TEST(EventMapTest, SameTimeEventsExecuteInScheduleOrder)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 10);
+    events.ScheduleEvent(2, 10);
+    events.ScheduleEvent(3, 10);
+    events.ScheduleEvent(4, 5);
+
+    events.Update(10);
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 4, 1, 2, 3 }));
+    EXPECT_TRUE(events.Empty());
+}
+
+TEST(EventMapTest, RepeatedEventExecutesAfterEventsOfTheSameTime)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 10);
+    events.ScheduleEvent(2, 20);
+
+    events.Update(10);
+    EXPECT_EQ(events.ExecuteEvent(), 1u);
+    events.RepeatEvent(10);
+
+    events.Update(10);
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 2, 1 }));
+}
+
+TEST(EventMapTest, DelayEventsOfGroupKeepsTheirOrder)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 10, 1);
+    events.ScheduleEvent(2, 10, 1);
+    events.ScheduleEvent(3, 20, 2);
+    events.ScheduleEvent(4, 10, 2);
+
+    events.DelayEvents(10, 1);
+    EXPECT_EQ(events.GetNextEventTime(1), 20u);
+    EXPECT_EQ(events.GetNextEventTime(2), 20u);
+
+    events.Update(10);
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 4 }));
+
+    events.Update(10);
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 3, 1, 2 }));
+}
+
+TEST(EventMapTest, DelayEventsToMax)
+{
+    EventMap events;
+    events.ScheduleEvent(1, 5, 1);
+    events.ScheduleEvent(2, 30, 1);
+    events.ScheduleEvent(3, 5, 2);
+    events.ScheduleEvent(4, 15, 1);
+    events.ScheduleEvent(5, 10, 1);
+
+    // only events of the group occurring before the delay are moved, behind the ones already at that time
+    events.DelayEventsToMax(15, 1);
+    EXPECT_EQ(events.GetNextEventTime(1), 15u);
+    EXPECT_EQ(events.GetNextEventTime(2), 30u);
+    EXPECT_EQ(events.GetNextEventTime(3), 5u);
+    EXPECT_EQ(events.GetNextEventTime(5), 15u);
+
+    events.Update(5);
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 3 }));
+
+    events.Update(10);
+    EXPECT_EQ(ExecuteAll(events), std::vector<uint32>({ 4, 1, 5 }));
+}
+
+TEST(EventMapTest, MatchesMultimapReference)
+{
+    std::mt19937 rng(7);
+    EventMap events;
+    ReferenceEventMap reference;
+
+    for (uint32 step = 0; step < 200000; ++step)
+    {
+        uint32 eventId = rng() % 20 + 1;
+        uint32 time = rng() % 50;
+        uint32 group = rng() % 10;
+        uint8 phase = rng() % 4;
+
+        switch (rng() % 12)
+        {
+            case 0:
+            case 1:
+            case 2:
+                events.ScheduleEvent(eventId, time, group, phase);
+                reference.ScheduleEvent(eventId, time, group, phase);
+                break;
+            case 3:
+                events.Update(time);
+                reference.Update(time);
+                break;
+            case 4:
+                while (uint32 executed = reference.ExecuteEvent())
+                {
+                    ASSERT_EQ(events.ExecuteEvent(), executed) << "step " << step;
+
+                    if (rng() % 4 == 0)
+                    {
+                        uint32 repeat = rng() % 30;
+                        events.RepeatEvent(repeat);
+                        reference.RepeatEvent(repeat);
+                    }
+                }
+
+                ASSERT_EQ(events.ExecuteEvent(), 0u) << "step " << step;
+                break;
+            case 5:
+                events.CancelEvent(eventId);
+                reference.CancelEvent(eventId);
+                break;
+            case 6:
+                events.CancelEventGroup(group);
+                reference.CancelEventGroup(group);
+                break;
+            case 7:
+                events.DelayEvents(time, group);
+                reference.DelayEvents(time, group);
+                break;
+            case 8:
+                events.DelayEventsToMax(time, group);
+                reference.DelayEventsToMax(time, group);
+                break;
+            case 9:
+                events.DelayEvents(time / 4);
+                reference.DelayEvents(time / 4);
+                break;
+            case 10:
+                events.SetPhase(phase);
+                reference.SetPhase(phase);
+                break;
+            case 11:
+                events.RescheduleEvent(eventId, time, group, phase);
+                reference.RescheduleEvent(eventId, time, group, phase);
+
+                if (rng() % 100 == 0)
+                {
+                    events.Reset();
+                    reference.Reset();
+                }
+                break;
+        }
+
+        ASSERT_EQ(events.GetNextEventTime(eventId), reference.GetNextEventTime(eventId)) << "step " << step;
+        ASSERT_EQ(events.GetNextEventTime(), reference.GetNextEventTime()) << "step " << step;
+    }
+}
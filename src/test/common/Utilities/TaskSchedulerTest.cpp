@@ -0,0 +1,262 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TaskScheduler.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace
+{
+    /// Plain list of tasks, the next task is the earliest one and of those the first inserted one
+    class ReferenceScheduler
+    {
+        struct Task
+        {
+            uint64 End;
+            uint64 Order;
+            std::optional<uint32> Group;
+            uint32 Id;
+            uint32 Repeated;
+        };
+
+    public:
+        void Schedule(uint32 time, std::optional<uint32> group, uint32 id)
+        {
+            _tasks.push_back({ _now + time, _order++, group, id, 0 });
+        }
+
+        template<typename Callback>
+        void Update(uint32 time, Callback&& callback)
+        {
+            _now += time;
+
+            while (!_tasks.empty())
+            {
+                auto next = std::min_element(_tasks.begin(), _tasks.end(), [](Task const& left, Task const& right)
+                {
+                    return left.End != right.End ? left.End < right.End : left.Order < right.Order;
+                });
+
+                if (next->End > _now)
+                    break;
+
+                Task task = *next;
+                _tasks.erase(next);
+
+                if (std::optional<uint32> repeat = callback(task.Id, task.Repeated))
+                {
+                    task.End += *repeat;
+                    task.Order = _order++;
+                    ++task.Repeated;
+                    _tasks.push_back(task);
+                }
+            }
+        }
+
+        void CancelGroup(uint32 group)
+        {
+            std::erase_if(_tasks, [group](Task const& task) { return task.Group == group; });
+        }
+
+        void DelayAll(uint32 delay)
+        {
+            Modify(std::nullopt, [delay](Task& task) { task.End += delay; });
+        }
+
+        void DelayGroup(uint32 group, uint32 delay)
+        {
+            Modify(group, [delay](Task& task) { task.End += delay; });
+        }
+
+        void RescheduleAll(uint32 time)
+        {
+            Modify(std::nullopt, [end = _now + time](Task& task) { task.End = end; });
+        }
+
+        void RescheduleGroup(uint32 group, uint32 time)
+        {
+            Modify(group, [end = _now + time](Task& task) { task.End = end; });
+        }
+
+        bool IsGroupScheduled(uint32 group) const
+        {
+            return std::any_of(_tasks.begin(), _tasks.end(), [group](Task const& task) { return task.Group == group; });
+        }
+
+    private:
+        // modified tasks are inserted again in the order they would have occurred before
+        template<typename Modifier>
+        void Modify(std::optional<uint32> group, Modifier&& modifier)
+        {
+            std::vector<Task> modified;
+            for (Task const& task : _tasks)
+                if (!group || task.Group == group)
+                    modified.push_back(task);
+
+            std::stable_sort(modified.begin(), modified.end(), [](Task const& left, Task const& right)
+            {
+                return left.End != right.End ? left.End < right.End : left.Order < right.Order;
+            });
+
+            for (Task& task : modified)
+            {
+                modifier(task);
+                task.Order = _order++;
+            }
+
+            std::erase_if(_tasks, [group](Task const& task) { return !group || task.Group == group; });
+            _tasks.insert(_tasks.end(), modified.begin(), modified.end());
+        }
+
+        uint64 _now{ 0 };
+        uint64 _order{ 0 };
+        std::vector<Task> _tasks;
+    };
+
+    // Repeats some of the tasks, decided by id and repetition only so both schedulers agree
+    std::optional<uint32> RepeatTime(uint32 id, uint32 repeated)
+    {
+        if ((id + repeated) % 3 != 0)
+            return std::nullopt;
+
+        return (id * 7 + repeated) % 50;
+    }
+}
+
+TEST(TaskSchedulerTest, SameTimeTasksRunInScheduleOrder)
+{
+    TaskScheduler scheduler;
+    std::vector<uint32> executed;
+
+    for (uint32 id = 1; id <= 3; ++id)
+        scheduler.Schedule(10ms, [&executed, id](TaskContext /*context*/) { executed.push_back(id); });
+
+    scheduler.Schedule(5ms, [&executed](TaskContext /*context*/) { executed.push_back(4); });
+
+    scheduler.Update(10ms);
+    EXPECT_EQ(executed, std::vector<uint32>({ 4, 1, 2, 3 }));
+}
+
+TEST(TaskSchedulerTest, DelayGroupKeepsTaskOrder)
+{
+    TaskScheduler scheduler;
+    std::vector<uint32> executed;
+
+    scheduler.Schedule(10ms, 1, [&executed](TaskContext /*context*/) { executed.push_back(1); });
+    scheduler.Schedule(10ms, 1, [&executed](TaskContext /*context*/) { executed.push_back(2); });
+    scheduler.Schedule(20ms, 2, [&executed](TaskContext /*context*/) { executed.push_back(3); });
+    scheduler.Schedule(10ms, 2, [&executed](TaskContext /*context*/) { executed.push_back(4); });
+
+    scheduler.DelayGroup(1, 10ms);
+
+    scheduler.Update(10ms);
+    EXPECT_EQ(executed, std::vector<uint32>({ 4 }));
+
+    scheduler.Update(10ms);
+    EXPECT_EQ(executed, std::vector<uint32>({ 4, 3, 1, 2 }));
+}
+
+TEST(TaskSchedulerTest, RescheduleAllKeepsTaskOrder)
+{
+    TaskScheduler scheduler;
+    std::vector<uint32> executed;
+
+    scheduler.Schedule(30ms, [&executed](TaskContext /*context*/) { executed.push_back(1); });
+    scheduler.Schedule(10ms, [&executed](TaskContext /*context*/) { executed.push_back(2); });
+    scheduler.Schedule(20ms, [&executed](TaskContext /*context*/) { executed.push_back(3); });
+    scheduler.Schedule(10ms, [&executed](TaskContext /*context*/) { executed.push_back(4); });
+
+    scheduler.RescheduleAll(5ms);
+
+    scheduler.Update(5ms);
+    EXPECT_EQ(executed, std::vector<uint32>({ 2, 4, 3, 1 }));
+}
+
+TEST(TaskSchedulerTest, MatchesReference)
+{
+    std::mt19937 rng(3);
+    TaskScheduler scheduler;
+    ReferenceScheduler reference;
+    std::vector<uint32> executed;
+    std::vector<uint32> expected;
+
+    for (uint32 step = 0; step < 20000; ++step)
+    {
+        uint32 group = rng() % 5;
+        uint32 time = rng() % 100;
+
+        switch (rng() % 9)
+        {
+            case 0:
+            case 1:
+            case 2:
+            {
+                auto task = [&executed, step](TaskContext context)
+                {
+                    executed.push_back(step);
+
+                    if (std::optional<uint32> repeat = RepeatTime(step, context.GetRepeatCounter()))
+                        context.Repeat(Milliseconds(*repeat));
+                };
+
+                if (group)
+                    scheduler.Schedule(Milliseconds(time), group, task);
+                else
+                    scheduler.Schedule(Milliseconds(time), task);
+
+                reference.Schedule(time, group ? std::optional<uint32>(group) : std::nullopt, step);
+                break;
+            }
+            case 3:
+                time %= 30;
+                scheduler.Update(Milliseconds(time));
+                reference.Update(time, [&expected](uint32 id, uint32 repeated)
+                {
+                    expected.push_back(id);
+                    return RepeatTime(id, repeated);
+                });
+                ASSERT_EQ(executed, expected) << "step " << step;
+                break;
+            case 4:
+                scheduler.CancelGroup(group);
+                reference.CancelGroup(group);
+                break;
+            case 5:
+                scheduler.DelayGroup(group, Milliseconds(time));
+                reference.DelayGroup(group, time);
+                break;
+            case 6:
+                scheduler.RescheduleGroup(group, Milliseconds(time));
+                reference.RescheduleGroup(group, time);
+                break;
+            case 7:
+                scheduler.DelayAll(Milliseconds(time));
+                reference.DelayAll(time);
+                break;
+            case 8:
+                scheduler.RescheduleAll(Milliseconds(time));
+                reference.RescheduleAll(time);
+                break;
+        }
+
+        ASSERT_EQ(scheduler.IsGroupScheduled(group), reference.IsGroupScheduled(group)) << "step " << step;
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PREPARED_RESULT_COLUMNS_DATA_H
+#define _PREPARED_RESULT_COLUMNS_DATA_H
+
+#include "QueryResult.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Rows shaped like the character cache query, shared by the column buffer tests
+namespace PreparedResultColumnsData
+{
+    // guid, name, account, race, gender, class, level - the character cache row
+    constexpr uint32 COLUMN_COUNT = 7;
+    constexpr uint32 SLOT_SIZES[COLUMN_COUNT] = { 4, 13, 4, 1, 1, 1, 1 };
+
+    inline std::vector<QueryResultFieldMetadata> MakeMetadata()
+    {
+        DatabaseFieldTypes const types[COLUMN_COUNT] = { DatabaseFieldTypes::Int32, DatabaseFieldTypes::Binary, DatabaseFieldTypes::Int32,
+            DatabaseFieldTypes::Int8, DatabaseFieldTypes::Int8, DatabaseFieldTypes::Int8, DatabaseFieldTypes::Int8 };
+
+        std::vector<QueryResultFieldMetadata> metadata(COLUMN_COUNT);
+        for (uint32 i = 0; i < COLUMN_COUNT; ++i)
+        {
+            metadata[i].Index = i;
+            metadata[i].Type = types[i];
+        }
+
+        return metadata;
+    }
+
+    inline void FillRow(PreparedResultColumns& columns, uint64 row)
+    {
+        uint32 guid = uint32(row + 1);
+        uint32 account = uint32(row / 10);
+        memcpy(columns.GetSlot(0, row), &guid, sizeof(guid));
+        memcpy(columns.GetSlot(2, row), &account, sizeof(account));
+        columns.SetLength(0, row, sizeof(guid));
+        columns.SetLength(2, row, sizeof(account));
+
+        int nameLength = snprintf(columns.GetSlot(1, row), SLOT_SIZES[1], "Char%u", guid);
+        columns.SetLength(1, row, uint32(nameLength));
+
+        for (uint32 i = 3; i < COLUMN_COUNT; ++i)
+        {
+            *columns.GetSlot(i, row) = char(row % (i * 10));
+            columns.SetLength(i, row, 1);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PreparedResultColumnsData.h"
+#include "gtest/gtest.h"
+#include <string>
+
+using namespace PreparedResultColumnsData;
+
+TEST(PreparedResultColumnsTest, ReadRow)
+{
+    std::vector<QueryResultFieldMetadata> metadata = MakeMetadata();
+    PreparedResultColumns columns;
+    columns.Allocate(SLOT_SIZES, COLUMN_COUNT, 10);
+
+    for (uint64 row = 0; row < 10; ++row)
+        FillRow(columns, row);
+
+    columns.SetLength(1, 5, PreparedResultColumns::NULL_LENGTH);
+
+    Field fields[COLUMN_COUNT];
+    columns.InitializeRow(fields, metadata.data());
+
+    for (uint64 row = 0; row < 10; ++row)
+    {
+        columns.ReadRow(row, fields);
+
+        EXPECT_EQ(fields[0].Get<uint32>(), row + 1);
+        EXPECT_EQ(fields[2].Get<uint32>(), row / 10);
+        EXPECT_EQ(fields[4].Get<uint8>(), row % 40);
+
+        if (row == 5)
+            EXPECT_TRUE(fields[1].IsNull());
+        else
+            EXPECT_EQ(fields[1].Get<std::string_view>(), "Char" + std::to_string(row + 1));
+    }
+}
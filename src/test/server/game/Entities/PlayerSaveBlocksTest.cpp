@@ -0,0 +1,99 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlayerSaveBlocks.h"
+#include "gtest/gtest.h"
+
+TEST(PlayerSaveBlocksTest, UnchangedBlockSkippedOnceCommitted)
+{
+    PlayerSaveBlocks blocks;
+
+    blocks.BeginSave(false);
+    EXPECT_TRUE(blocks.IsChanged(PLAYER_SAVE_BLOCK_AURAS, 1, 5));
+    PlayerSaveBlocks::Confirmation first = blocks.GetConfirmation();
+
+    // not committed yet, written again
+    blocks.BeginSave(false);
+    EXPECT_TRUE(blocks.IsChanged(PLAYER_SAVE_BLOCK_AURAS, 1, 5));
+    EXPECT_EQ(blocks.GetSkippedStatements(), 0u);
+    PlayerSaveBlocks::Confirmation second = blocks.GetConfirmation();
+
+    // the block was written again since, only its latest save confirms it
+    blocks.Confirm(first);
+    blocks.BeginSave(false);
+    EXPECT_TRUE(blocks.IsChanged(PLAYER_SAVE_BLOCK_AURAS, 1, 5));
+    blocks.Confirm(second);
+    blocks.Confirm(blocks.GetConfirmation());
+
+    blocks.BeginSave(false);
+    EXPECT_FALSE(blocks.IsChanged(PLAYER_SAVE_BLOCK_AURAS, 1, 5));
+    EXPECT_TRUE(blocks.IsChanged(PLAYER_SAVE_BLOCK_STATS, 2, 2));
+    EXPECT_EQ(blocks.GetSkippedStatements(), 5u);
+
+    // the skipped block stays confirmed
+    blocks.Confirm(blocks.GetConfirmation());
+    blocks.BeginSave(false);
+    EXPECT_FALSE(blocks.IsChanged(PLAYER_SAVE_BLOCK_AURAS, 1, 5));
+    EXPECT_FALSE(blocks.IsChanged(PLAYER_SAVE_BLOCK_STATS, 2, 2));
+    EXPECT_EQ(blocks.GetSkippedStatements(), 7u);
+}
+
+TEST(PlayerSaveBlocksTest, ChangedBlockWrittenUntilCommitted)
+{
+    PlayerSaveBlocks blocks;
+
+    blocks.BeginSave(false);
+    blocks.IsChanged(PLAYER_SAVE_BLOCK_STATS, 1, 2);
+    blocks.Confirm(blocks.GetConfirmation());
+
+    blocks.BeginSave(false);
+    EXPECT_TRUE(blocks.IsChanged(PLAYER_SAVE_BLOCK_STATS, 2, 2));
+
+    // a failed commit is never confirmed, the old data can't be assumed either
+    blocks.BeginSave(false);
+    EXPECT_TRUE(blocks.IsChanged(PLAYER_SAVE_BLOCK_STATS, 1, 2));
+    EXPECT_EQ(blocks.GetSkippedStatements(), 0u);
+}
+
+TEST(PlayerSaveBlocksTest, LogoutWritesAllBlocks)
+{
+    PlayerSaveBlocks blocks;
+
+    blocks.BeginSave(false);
+    blocks.IsChanged(PLAYER_SAVE_BLOCK_ENTRY_POINT, 1, 2);
+    blocks.Confirm(blocks.GetConfirmation());
+
+    blocks.BeginSave(true);
+    EXPECT_TRUE(blocks.IsChanged(PLAYER_SAVE_BLOCK_ENTRY_POINT, 1, 2));
+    EXPECT_EQ(blocks.GetSkippedStatements(), 0u);
+}
+
+TEST(PlayerSaveBlocksTest, ConfirmationOfOtherTrackerIgnored)
+{
+    PlayerSaveBlocks previousLogin;
+    previousLogin.BeginSave(false);
+    previousLogin.IsChanged(PLAYER_SAVE_BLOCK_AURAS, 1, 3);
+
+    // a new login of the character, the commit of the old session completes late
+    PlayerSaveBlocks blocks;
+    blocks.BeginSave(false);
+    blocks.IsChanged(PLAYER_SAVE_BLOCK_AURAS, 2, 3);
+    blocks.Confirm(previousLogin.GetConfirmation());
+
+    blocks.BeginSave(false);
+    EXPECT_TRUE(blocks.IsChanged(PLAYER_SAVE_BLOCK_AURAS, 1, 3));
+}
@@ -0,0 +1,180 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridFilter.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Warhead::GridFilter;
+
+namespace
+{
+    struct Candidates
+    {
+        std::vector<float> X;
+        std::vector<float> Y;
+        std::vector<float> Size;
+        std::vector<uint32> PhaseMask;
+
+        void Add(float x, float y, float size, uint32 phaseMask)
+        {
+            X.push_back(x);
+            Y.push_back(y);
+            Size.push_back(size);
+            PhaseMask.push_back(phaseMask);
+        }
+
+        uint64 Run(FilterFunction filter, Query const& query, uint32 offset, uint32 count) const
+        {
+            return filter(query, X.data() + offset, Y.data() + offset, Size.data() + offset, PhaseMask.data() + offset, count);
+        }
+    };
+
+    Candidates MakeRandomCandidates(uint32 count, uint32 seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> pos(-60.0f, 60.0f);
+        std::uniform_real_distribution<float> size(0.0f, 5.0f);
+        std::uniform_int_distribution<uint32> phaseBit(0, 7);
+
+        Candidates candidates;
+        for (uint32 i = 0; i < count; ++i)
+            candidates.Add(pos(rng), pos(rng), size(rng), (i % 5) ? 1u << phaseBit(rng) : 0x3u);
+
+        return candidates;
+    }
+
+    std::vector<Implementation> GetSupportedImplementations()
+    {
+        std::vector<Implementation> result;
+        for (Implementation impl : { Implementation::Scalar, Implementation::SSE2, Implementation::AVX2 })
+            if (GetFunction(impl))
+                result.push_back(impl);
+
+        return result;
+    }
+}
+
+TEST(GridFilterTest, BestImplementationIsSupported)
+{
+    EXPECT_NE(GetFunction(Implementation::Scalar), nullptr);
+    EXPECT_NE(GetFunction(GetBestImplementation()), nullptr);
+}
+
+TEST(GridFilterTest, ScalarPhase)
+{
+    Candidates candidates;
+    candidates.Add(0.0f, 0.0f, 0.0f, 0x1); // shares a bit
+    candidates.Add(0.0f, 0.0f, 0.0f, 0x6); // shares a bit
+    candidates.Add(0.0f, 0.0f, 0.0f, 0x8); // no common bit
+    candidates.Add(0.0f, 0.0f, 0.0f, 0x0); // phase 0 only matches phase 0
+
+    Query query;
+    query.CheckPhase = true;
+    query.PhaseMask = 0x3;
+    EXPECT_EQ(candidates.Run(GetFunction(Implementation::Scalar), query, 0, 4), 0x3u);
+
+    query.PhaseMask = 0x0;
+    EXPECT_EQ(candidates.Run(GetFunction(Implementation::Scalar), query, 0, 4), 0x8u);
+
+    query.CheckPhase = false;
+    EXPECT_EQ(candidates.Run(GetFunction(Implementation::Scalar), query, 0, 4), 0xFu);
+}
+
+TEST(GridFilterTest, ScalarDistance)
+{
+    Candidates candidates;
+    candidates.Add(3.0f, 4.0f, 0.0f, 1);  // exactly 5 yards away
+    candidates.Add(6.0f, 8.0f, 0.0f, 1);  // 10 yards
+    candidates.Add(6.0f, 8.0f, 5.0f, 1);  // 10 yards, reaches 5 with its size
+    candidates.Add(0.0f, 0.0f, 0.0f, 1);  // on the center
+
+    Query query;
+    query.Radius = 5.0f;
+    EXPECT_EQ(candidates.Run(GetFunction(Implementation::Scalar), query, 0, 4), 0xDu);
+
+    query.AddObjectSize = false;
+    EXPECT_EQ(candidates.Run(GetFunction(Implementation::Scalar), query, 0, 4), 0x9u);
+
+    query.Radius = 0.0f;
+    EXPECT_EQ(candidates.Run(GetFunction(Implementation::Scalar), query, 0, 4), 0xFu);
+}
+
+TEST(GridFilterTest, ImplementationsMatchScalar)
+{
+    Candidates candidates = MakeRandomCandidates(MAX_BATCH * 4, 12345);
+    FilterFunction scalar = GetFunction(Implementation::Scalar);
+
+    std::vector<Query> queries;
+    for (float radius : { 0.0f, 10.0f, 35.5f })
+        for (bool addObjectSize : { false, true })
+            for (bool checkPhase : { false, true })
+            {
+                Query query;
+                query.X = 3.5f;
+                query.Y = -7.25f;
+                query.Radius = radius;
+                query.AddObjectSize = addObjectSize;
+                query.CheckPhase = checkPhase;
+                query.PhaseMask = 0x5;
+                queries.push_back(query);
+            }
+
+    for (Implementation impl : GetSupportedImplementations())
+    {
+        FilterFunction filter = GetFunction(impl);
+        for (Query const& query : queries)
+            // every batch length and an unaligned start to cover the scalar tails
+            for (uint32 offset : { 0u, 3u })
+                for (uint32 count = 0; count <= MAX_BATCH; ++count)
+                    EXPECT_EQ(candidates.Run(filter, query, offset, count), candidates.Run(scalar, query, offset, count))
+                        << GetImplementationName(impl) << " offset " << offset << " count " << count;
+    }
+}
+
+// microbenchmark, run with --gtest_also_run_disabled_tests --gtest_filter=GridFilterTest.*
+TEST(GridFilterTest, DISABLED_Throughput)
+{
+    constexpr uint32 candidateCount = 4096;
+    constexpr uint32 rounds = 20000;
+    Candidates candidates = MakeRandomCandidates(candidateCount, 777);
+
+    Query query;
+    query.Radius = 20.0f;
+    query.CheckPhase = true;
+    query.PhaseMask = 0x1;
+
+    for (Implementation impl : GetSupportedImplementations())
+    {
+        FilterFunction filter = GetFunction(impl);
+        uint64 checksum = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32 round = 0; round < rounds; ++round)
+            for (uint32 offset = 0; offset < candidateCount; offset += MAX_BATCH)
+                checksum += candidates.Run(filter, query, offset, MAX_BATCH);
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        // ns per candidate, the checksum keeps the filter calls from being optimized out
+        std::string name = GetImplementationName(impl);
+        RecordProperty(name + "NsPerCandidate", std::to_string(elapsed / (double(rounds) * candidateCount)));
+        RecordProperty(name + "Checksum", std::to_string(checksum));
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ * This file is part of the WarheadCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SpellAuraPool.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // the free lists are per thread, a new thread starts with empty lists
+    void RunOnNewThread(std::function<void()> const& test)
+    {
+        std::thread thread(test);
+        thread.join();
+    }
+}
+
+TEST(SpellAuraPoolTest, FreedBlockReusedBySameSizeClass)
+{
+    RunOnNewThread([]()
+    {
+        void* block = SpellAuraPool::Allocate(40);
+        SpellAuraPool::Deallocate(block, 40);
+
+        // 33 to 48 bytes share a size class
+        void* reused = SpellAuraPool::Allocate(33);
+        EXPECT_EQ(reused, block);
+
+        void* other = SpellAuraPool::Allocate(40);
+        EXPECT_NE(other, block);
+
+        SpellAuraPool::Deallocate(other, 40);
+        SpellAuraPool::Deallocate(reused, 33);
+
+        // last freed, first reused
+        EXPECT_EQ(SpellAuraPool::Allocate(48), reused);
+        EXPECT_EQ(SpellAuraPool::Allocate(48), other);
+
+        SpellAuraPool::Deallocate(other, 48);
+        SpellAuraPool::Deallocate(reused, 48);
+    });
+}
+
+TEST(SpellAuraPoolTest, FreeBlocksCappedPerSizeClass)
+{
+    RunOnNewThread([]()
+    {
+        std::vector<void*> blocks;
+        for (uint32 i = 0; i < 4097; ++i)
+            blocks.push_back(SpellAuraPool::Allocate(64));
+
+        for (void* block : blocks)
+            SpellAuraPool::Deallocate(block, 64);
+
+        // the last block went back to the heap, the pool hands out the one freed before it
+        for (uint32 i = 0; i < 4096; ++i)
+            EXPECT_EQ(SpellAuraPool::Allocate(64), blocks[4095 - i]);
+
+        blocks.pop_back();
+        for (void* block : blocks)
+            SpellAuraPool::Deallocate(block, 64);
+    });
+}
+
+TEST(SpellAuraPoolTest, LargeBlocksBypassPool)
+{
+    RunOnNewThread([]()
+    {
+        void* pooled = SpellAuraPool::Allocate(1024);
+        SpellAuraPool::Deallocate(pooled, 1024);
+
+        void* large = SpellAuraPool::Allocate(1025);
+        std::memset(large, 0xAB, 1025);
+        SpellAuraPool::Deallocate(large, 1025);
+
+        large = SpellAuraPool::Allocate(4096);
+        std::memset(large, 0xCD, 4096);
+        SpellAuraPool::Deallocate(large, 4096);
+
+        // the largest size class is left untouched by the heap blocks
+        EXPECT_EQ(SpellAuraPool::Allocate(1010), pooled);
+        SpellAuraPool::Deallocate(pooled, 1010);
+    });
+}